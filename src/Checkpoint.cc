@@ -0,0 +1,322 @@
+/*
+ * Checkpoint.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Checkpoint.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "Parallel.hh"
+#include "Timer.hh"
+
+using namespace std;
+
+
+string Checkpoint::fileName(const string& basename, const int pe) {
+    ostringstream oss;
+    oss << basename << "." << pe;
+    return oss.str();
+}
+
+
+ChkptWriter::ChkptWriter() {}
+
+ChkptWriter::~ChkptWriter() {}
+
+
+void ChkptWriter::add(
+        const char* name,
+        const void* ptr,
+        const int64_t bytes) {
+    Block b;
+    memset(b.name, 0, Checkpoint::namelen);
+    strncpy(b.name, name, Checkpoint::namelen - 1);
+    b.ptr = (const char*) ptr;
+    b.src = b.ptr;
+    b.bytes = bytes;
+    blocks.push_back(b);
+}
+
+
+#ifdef USE_SOA
+void ChkptWriter::add(
+        const char* name,
+        const double2ptr& ptr,
+        const int count) {
+    add((string(name) + ".x").c_str(), ptr.x, count);
+    add((string(name) + ".y").c_str(), ptr.y, count);
+}
+#endif
+
+
+int64_t ChkptWriter::size() const {
+    int64_t sum = 0;
+    for (int i = 0; i < blocks.size(); ++i)
+        sum += Checkpoint::namelen + sizeof(int64_t) + blocks[i].bytes;
+    return sum;
+}
+
+
+void ChkptWriter::stage(vector<char>& buf) {
+
+    int64_t total = 0;
+    vector<int64_t> offset(blocks.size());
+    for (int i = 0; i < blocks.size(); ++i) {
+        offset[i] = total;
+        total += blocks[i].bytes;
+    }
+    if (buf.size() < total) buf.resize(total);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].bytes > 0)
+            memcpy(&buf[offset[i]], blocks[i].ptr, blocks[i].bytes);
+    }
+    for (int i = 0; i < blocks.size(); ++i)
+        blocks[i].ptr = &buf[offset[i]];
+
+}
+
+
+void ChkptWriter::restore() const {
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < blocks.size(); ++i) {
+        const Block& b = blocks[i];
+        if (b.bytes > 0 && b.ptr != b.src)
+            memcpy((char*) b.src, b.ptr, b.bytes);
+    }
+
+}
+
+
+bool ChkptWriter::write(const string& filename) const {
+
+    using Parallel::numpe;
+    using Parallel::mype;
+
+    // write to a temporary name, then rename, so that an
+    // interrupted write never leaves a partial checkpoint
+    const string tmpname = filename + ".tmp";
+    ofstream ofs(tmpname.c_str(), ios::binary);
+    if (!ofs.good()) {
+        cerr << "Cannot open file " << tmpname << " for writing"
+             << endl;
+        return false;
+    }
+
+    ofs.write(Checkpoint::magic, sizeof(Checkpoint::magic));
+    ofs.write((const char*) &Checkpoint::version, sizeof(int));
+    ofs.write((const char*) &numpe, sizeof(int));
+    ofs.write((const char*) &mype, sizeof(int));
+
+    for (int i = 0; i < blocks.size(); ++i) {
+        const Block& b = blocks[i];
+        ofs.write(b.name, Checkpoint::namelen);
+        ofs.write((const char*) &b.bytes, sizeof(int64_t));
+        ofs.write(b.ptr, b.bytes);
+    }
+    ofs.close();
+    if (ofs.fail()) {
+        cerr << "Error writing checkpoint file " << tmpname << endl;
+        return false;
+    }
+
+    if (rename(tmpname.c_str(), filename.c_str()) != 0) {
+        cerr << "Cannot rename " << tmpname << " to " << filename
+             << endl;
+        return false;
+    }
+    return true;
+
+}
+
+
+ChkptThread::ChkptThread()
+    : busy(false), quit(false), lastok(true),
+      numwrites(0), tstage(0.), twait(0.), twrite(0.) {
+
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&cond, NULL);
+    if (pthread_create(&thread, NULL, threadMain, this) != 0) {
+        cerr << "Error: cannot create checkpoint I/O thread" << endl;
+        exit(1);
+    }
+
+}
+
+
+ChkptThread::~ChkptThread() {
+
+    wait();
+    pthread_mutex_lock(&mutex);
+    quit = true;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+    pthread_join(thread, NULL);
+    pthread_cond_destroy(&cond);
+    pthread_mutex_destroy(&mutex);
+
+}
+
+
+void ChkptThread::submit(
+        const ChkptWriter& cw,
+        const string& filename) {
+
+    // no lock needed for staging:  the I/O thread is idle
+    double t0 = Timer::now();
+    job = cw;
+    job.stage(stagebuf);
+    tstage += Timer::now() - t0;
+
+    pthread_mutex_lock(&mutex);
+    jobname = filename;
+    busy = true;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+
+}
+
+
+bool ChkptThread::wait() {
+
+    double t0 = Timer::now();
+    pthread_mutex_lock(&mutex);
+    while (busy)
+        pthread_cond_wait(&cond, &mutex);
+    bool ok = lastok;
+    pthread_mutex_unlock(&mutex);
+    twait += Timer::now() - t0;
+    return ok;
+
+}
+
+
+void* ChkptThread::threadMain(void* arg) {
+    ((ChkptThread*) arg)->loop();
+    return NULL;
+}
+
+
+void ChkptThread::loop() {
+
+    pthread_mutex_lock(&mutex);
+    while (true) {
+        while (!busy && !quit)
+            pthread_cond_wait(&cond, &mutex);
+        if (!busy) break;
+        pthread_mutex_unlock(&mutex);
+
+        double t0 = Timer::now();
+        bool ok = job.write(jobname);
+        double t = Timer::now() - t0;
+
+        pthread_mutex_lock(&mutex);
+        lastok = ok;
+        twrite += t;
+        numwrites += 1;
+        busy = false;
+        pthread_cond_broadcast(&cond);
+    }
+    pthread_mutex_unlock(&mutex);
+
+}
+
+
+ChkptReader::ChkptReader(const string& fname) : filename(fname) {
+
+    using Parallel::numpe;
+    using Parallel::mype;
+
+    ifs.open(filename.c_str(), ios::binary);
+    if (!ifs.good()) fail("cannot open file");
+
+    char fmagic[sizeof(Checkpoint::magic)];
+    int fversion, fnumpe, fmype;
+    ifs.read(fmagic, sizeof(fmagic));
+    ifs.read((char*) &fversion, sizeof(int));
+    ifs.read((char*) &fnumpe, sizeof(int));
+    ifs.read((char*) &fmype, sizeof(int));
+    if (!ifs.good() ||
+            memcmp(fmagic, Checkpoint::magic, sizeof(fmagic)) != 0)
+        fail("not a PENNANT checkpoint file");
+    if (fversion != Checkpoint::version)
+        fail("unsupported checkpoint version");
+    if (fnumpe != numpe || fmype != mype) {
+        ostringstream oss;
+        oss << "written by PE " << fmype << " of " << fnumpe
+            << ", but this is PE " << mype << " of " << numpe;
+        fail(oss.str());
+    }
+
+}
+
+
+ChkptReader::~ChkptReader() {}
+
+
+int64_t ChkptReader::next(const char* name) {
+    char fname[Checkpoint::namelen];
+    int64_t bytes;
+    ifs.read(fname, Checkpoint::namelen);
+    ifs.read((char*) &bytes, sizeof(int64_t));
+    if (!ifs.good()) fail(string("unexpected end of file at ") + name);
+    fname[Checkpoint::namelen - 1] = '\0';
+    if (strcmp(fname, name) != 0)
+        fail(string("expected block ") + name + ", found " + fname);
+    return bytes;
+}
+
+
+void ChkptReader::read(
+        const char* name,
+        void* ptr,
+        const int64_t bytes) {
+    int64_t fbytes = next(name);
+    if (fbytes != bytes) {
+        ostringstream oss;
+        oss << "block " << name << " has " << fbytes
+            << " bytes, expected " << bytes;
+        fail(oss.str());
+    }
+    readData(name, ptr, bytes);
+}
+
+
+#ifdef USE_SOA
+void ChkptReader::read(
+        const char* name,
+        const double2ptr& ptr,
+        const int count) {
+    read((string(name) + ".x").c_str(), ptr.x, count);
+    read((string(name) + ".y").c_str(), ptr.y, count);
+}
+#endif
+
+
+void ChkptReader::readData(
+        const char* name,
+        void* ptr,
+        const int64_t bytes) {
+    ifs.read((char*) ptr, bytes);
+    if (!ifs.good()) fail(string("error reading block ") + name);
+}
+
+
+void ChkptReader::fail(const string& msg) {
+    cerr << "Error: restart file " << filename << ": " << msg << endl;
+    cerr << "Exiting..." << endl;
+    exit(1);
+}
@@ -0,0 +1,189 @@
+/*
+ * Checkpoint.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef CHECKPOINT_HH_
+#define CHECKPOINT_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <pthread.h>
+
+#include "Vec2Array.hh"
+
+
+// A checkpoint file holds the state of one PE as a short header
+// followed by a sequence of named binary blocks:
+//     header:  magic[8], version, numpe, mype
+//     block:   name[16], size in bytes (int64), raw data
+// Blocks are written and read back in the same fixed order, and
+// each block's name and size are checked on reading.
+
+namespace Checkpoint {
+    const char magic[8] = { 'P', 'N', 'N', 'T', 'C', 'H', 'K', 0 };
+    const int version = 3;
+    const int namelen = 16;
+
+    // name of the file for a given PE
+    std::string fileName(const std::string& basename, const int pe);
+}  // namespace Checkpoint
+
+
+// Class ChkptWriter collects a list of blocks pointing to live
+// data, then writes them all out at once.
+
+class ChkptWriter {
+public:
+
+    struct Block {
+        char name[Checkpoint::namelen];
+        const char* ptr;
+        const char* src;           // location of live data
+        int64_t bytes;
+    };
+
+    std::vector<Block> blocks;     // blocks to write, in order
+
+    ChkptWriter();
+    ~ChkptWriter();
+
+    void add(const char* name, const void* ptr, const int64_t bytes);
+
+    template <typename T>
+    void add(const char* name, const T* ptr, const int count) {
+        add(name, (const void*) ptr, (int64_t) count * sizeof(T));
+    }
+
+    template <typename T>
+    void add(const char* name, const T& x) {
+        add(name, &x, 1);
+    }
+
+    template <typename T>
+    void add(const char* name, const std::vector<T>& v) {
+        add(name, (v.empty() ? NULL : &v[0]), (int) v.size());
+    }
+
+#ifdef USE_SOA
+    // a double2 array is written as two blocks, name.x and name.y
+    void add(const char* name, const double2ptr& ptr, const int count);
+#endif
+
+    // total size of all blocks
+    int64_t size() const;
+
+    // copy all block data into buf, and point the blocks there,
+    // so that the live data may change before the write happens
+    void stage(std::vector<char>& buf);
+
+    // copy staged block data back to the live data, so that a
+    // staged writer can serve as an in-memory snapshot
+    void restore() const;
+
+    // write header and all blocks to a file; returns false on
+    // I/O error
+    bool write(const std::string& filename) const;
+
+};  // class ChkptWriter
+
+
+// Class ChkptThread writes checkpoints on a background I/O
+// thread, so that the hydro cycle can continue during the write.
+// Block data is copied to a staging buffer on submit, and the
+// caller only blocks if the previous write hasn't finished yet.
+// The I/O thread makes no MPI calls.
+
+class ChkptThread {
+public:
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    ChkptWriter job;               // checkpoint being written
+    std::string jobname;           // file name for job
+    bool busy;                     // true while job is in progress
+    bool quit;                     // true when thread should exit
+    bool lastok;                   // result of last write
+    std::vector<char> stagebuf;    // staging copy of job data
+
+    int numwrites;                 // number of checkpoints written
+    double tstage;                 // time spent staging (exposed)
+    double twait;                  // time spent waiting for the
+                                   // I/O thread (exposed)
+    double twrite;                 // time spent writing (on the
+                                   // I/O thread)
+
+    ChkptThread();
+    ~ChkptThread();
+
+    // stage a checkpoint and start writing it; the previous
+    // write must already have been waited for
+    void submit(const ChkptWriter& cw, const std::string& filename);
+
+    // block until no write is in progress; returns false if the
+    // last write failed
+    bool wait();
+
+private:
+    static void* threadMain(void* arg);
+    void loop();
+
+};  // class ChkptThread
+
+
+// Class ChkptReader reads blocks back from a checkpoint file, in
+// the order they were written.  Any mismatch is a fatal error.
+
+class ChkptReader {
+public:
+
+    std::string filename;
+    std::ifstream ifs;
+
+    ChkptReader(const std::string& fname);
+    ~ChkptReader();
+
+    // read the next block header, check its name, return its size
+    int64_t next(const char* name);
+
+    void read(const char* name, void* ptr, const int64_t bytes);
+
+    template <typename T>
+    void read(const char* name, T* ptr, const int count) {
+        read(name, (void*) ptr, (int64_t) count * sizeof(T));
+    }
+
+    template <typename T>
+    void read(const char* name, T& x) {
+        read(name, &x, 1);
+    }
+
+#ifdef USE_SOA
+    void read(const char* name, const double2ptr& ptr, const int count);
+#endif
+
+    template <typename T>
+    void read(const char* name, std::vector<T>& v) {
+        int64_t bytes = next(name);
+        v.resize(bytes / sizeof(T));
+        readData(name, (v.empty() ? NULL : &v[0]), bytes);
+    }
+
+private:
+    void readData(const char* name, void* ptr, const int64_t bytes);
+    void fail(const std::string& msg);
+
+};  // class ChkptReader
+
+
+#endif /* CHECKPOINT_HH_ */
@@ -14,6 +14,8 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
+#include <cmath>
 #include <sys/time.h>
 #include <iostream>
 #include <fstream>
@@ -27,6 +29,13 @@
 #include "InputFile.hh"
 #include "Mesh.hh"
 #include "Hydro.hh"
+#include "QCS.hh"
+#include "HydroBC.hh"
+#include "Timer.hh"
+#include "Roofline.hh"
+#include "Checkpoint.hh"
+#include "Memory.hh"
+#include "PerfCounters.hh"
 
 using namespace std;
 
@@ -36,7 +45,9 @@ Driver::Driver(const InputFile* inp, const string& pname)
     using Parallel::numpe;
     using Parallel::mype;
 
-    if (mype == 0) {
+    quiet = inp->getInt("quiet", 0);
+
+    if (mype == 0 && !quiet) {
         cout << "********************" << endl;
         cout << "Running PENNANT v0.9" << endl;
         cout << "********************" << endl;
@@ -62,71 +73,184 @@ Driver::Driver(const InputFile* inp, const string& pname)
     dtinit = inp->getDouble("dtinit", 1.e99);
     dtfac = inp->getDouble("dtfac", 1.2);
     dtreport = inp->getInt("dtreport", 10);
+    benchcycles = inp->getInt("benchcycles", 0);
+    benchwarmup = inp->getInt("benchwarmup", 5);
+    if (benchcycles < 0 || benchwarmup < 0) {
+        if (mype == 0)
+            cerr << "Error: bad benchcycles or benchwarmup" << endl;
+        exit(1);
+    }
+    chkptcycles = inp->getInt("chkptcycles", 0);
+    chkptwall = inp->getDouble("chkptwall", 0.);
+    chkthread = NULL;
+    if (inp->getInt("chkptasync", 0))
+        chkthread = new ChkptThread();
+
+    chunkcands = inp->getDoubleList("chunkcands", vector<double>());
+    chunktunecycles = inp->getInt("chunktunecycles", 3);
+    if (chunktunecycles < 1) {
+        if (mype == 0)
+            cerr << "Error: bad chunktunecycles " << chunktunecycles
+                 << endl;
+        exit(1);
+    }
+
+    // open restart file, if any
+    ChkptReader* cr = NULL;
+    string rsname = inp->getString("restart", "");
+    if (rsname != "") {
+        cr = new ChkptReader(Checkpoint::fileName(rsname, mype));
+        if (mype == 0 && !quiet)
+            cout << "Restarting from " << rsname << endl;
+    }
+
+    // initialize timer, mesh, hydro
+    timer = new Timer(inp);
+    mesh = new Mesh(inp, timer, cr);
+    hydro = new Hydro(inp, mesh, cr);
+
+    time = 0.0;
+    cycle = 0;
+    if (cr) {
+        initFromChkpt(*cr);
+        delete cr;
+    }
+
+    // in benchmark mode, run a fixed number of cycles
+    // regardless of the problem's stopping criteria
+    if (benchcycles > 0) {
+        cstop = cycle + benchwarmup + benchcycles;
+        tstop = 1.e99;
+        if (mype == 0 && !quiet)
+            cout << "Benchmark mode:  " << benchwarmup
+                 << " warm-up cycles, " << benchcycles
+                 << " timed cycles" << endl;
+    }
 
-    // initialize mesh, hydro
-    mesh = new Mesh(inp);
-    hydro = new Hydro(inp, mesh);
+    // set up traffic model, run bandwidth probe
+    roofline = NULL;
+    if (inp->getInt("roofline", 0)) {
+        if (!timer->enabled) {
+            if (mype == 0)
+                cerr << "Error: roofline requires phasetimers" << endl;
+            exit(1);
+        }
+        roofline = new Roofline(inp, mesh, hydro);
+    }
 
 }
 
 Driver::~Driver() {
 
+    delete chkthread;
+    delete roofline;
     delete hydro;
     delete mesh;
+    delete timer;
 
 }
 
 void Driver::run() {
-    using Parallel::mype;
 
-    time = 0.0;
-    cycle = 0;
+    start();
+    while (!done())
+        step();
+    finish();
+
+}
+
+
+void Driver::start() {
 
     // do energy check
-    hydro->writeEnergyCheck();
+    if (!quiet) hydro->writeEnergyCheck();
 
-    double tbegin, tlast;
-    if (mype == 0) {
-        // get starting timestamp
-        struct timeval sbegin;
-        gettimeofday(&sbegin, NULL);
-        tbegin = sbegin.tv_sec + sbegin.tv_usec * 1.e-6;
-        tlast = tbegin;
-    }
+    if (mesh->chunkauto) tuneChunks();
+
+    // get starting timestamp
+    struct timeval sbegin;
+    gettimeofday(&sbegin, NULL);
+    tbegin = sbegin.tv_sec + sbegin.tv_usec * 1.e-6;
+    tlast = tbegin;
+    tchkpt = Timer::now();
+
+    // first cycle counted in timing reports
+    cyclebegin = cycle;
+    cycle0 = cycle;
+    if (benchwarmup == 0) cyctime.reserve(benchcycles);
 
-    // main event loop
-    while (cycle < cstop && time < tstop) {
+}
 
-        cycle += 1;
 
-        // get timestep
-        calcGlobalDt();
+bool Driver::done() const {
+    return (cycle >= cstop || time >= tstop);
+}
 
-        // begin hydro cycle
-        hydro->doCycle(dt);
 
-        time += dt;
+void Driver::step() {
+    using Parallel::mype;
 
-        if (mype == 0 &&
-                (cycle == 1 || cycle % dtreport == 0)) {
-            struct timeval scurr;
-            gettimeofday(&scurr, NULL);
-            double tcurr = scurr.tv_sec + scurr.tv_usec * 1.e-6;
-            double tdiff = tcurr - tlast;
+    cycle += 1;
+    double tcyc = Timer::now();
 
-            cout << scientific << setprecision(5);
-            cout << "End cycle " << setw(6) << cycle
-                 << ", time = " << setw(11) << time
-                 << ", dt = " << setw(11) << dt
-                 << ", wall = " << setw(11) << tdiff << endl;
-            cout << "dt limiter: " << msgdt << endl;
+    // get timestep
+    double t0 = timer->start();
+    calcGlobalDt();
+    timer->lap(Timer::PH_GLOBALDT, t0);
 
-            tlast = tcurr;
-        } // if mype...
+    // begin hydro cycle
+    hydro->doCycle(dt);
 
-    } // while cycle...
+    time += dt;
+
+    if (benchcycles > 0) {
+        if (cycle - cyclebegin > benchwarmup)
+            cyctime.push_back(Timer::now() - tcyc);
+        else if (cycle - cyclebegin == benchwarmup) {
+            // start phase timers over after warm-up
+            timer->reset();
+            cycle0 = cycle;
+            cyctime.reserve(benchcycles);
+        }
+    }
+
+    if (mype == 0 && !quiet &&
+            (cycle == 1 || cycle % dtreport == 0)) {
+        struct timeval scurr;
+        gettimeofday(&scurr, NULL);
+        double tcurr = scurr.tv_sec + scurr.tv_usec * 1.e-6;
+        double tdiff = tcurr - tlast;
+
+        cout << scientific << setprecision(5);
+        cout << "End cycle " << setw(6) << cycle
+             << ", time = " << setw(11) << time
+             << ", dt = " << setw(11) << dt
+             << ", wall = " << setw(11) << tdiff << endl;
+        cout << "dt limiter: " << msgdt << endl;
+
+        tlast = tcurr;
+    } // if mype...
+
+    // write checkpoint if due; all PEs must agree on
+    // the wall-clock test
+    bool dochkpt = (chkptcycles > 0 && cycle % chkptcycles == 0);
+    if (chkptwall > 0.) {
+        double twall = Timer::now() - tchkpt;
+        Parallel::globalMax(twall);
+        if (twall >= chkptwall) dochkpt = true;
+    }
+    if (dochkpt) {
+        writeChkpt();
+        tchkpt = Timer::now();
+    }
+
+}
 
-    if (mype == 0) {
+
+void Driver::finish() {
+    using Parallel::mype;
+
+    if (mype == 0 && !quiet) {
 
         // get stopping timestamp
         struct timeval send;
@@ -150,8 +274,32 @@ void Driver::run() {
 
     } // if mype
 
+    // wait for any checkpoint still being written
+    if (chkthread) finishChkpt();
+
+    if (benchcycles > 0) writeBench();
+
+    // write phase timing tables
+    if (!quiet) {
+        timer->write(probname, cycle - cycle0);
+        if (roofline)
+            roofline->write(&timer->petime[0], cycle - cycle0);
+    }
+
     // do energy check
-    hydro->writeEnergyCheck();
+    if (!quiet) hydro->writeEnergyCheck();
+
+    // report check of QCS SIMD loops, if requested
+    hydro->qcs->writeSimdCheck();
+
+    // report use of scratch arrays
+    if (!quiet) writeScratch();
+
+    // report memory held by each field
+    if (!quiet) writeMemory();
+
+    // report NUMA page placement, if requested
+    if (mesh->numareport && !quiet) mesh->writePlacement();
 
     // do final mesh output
     mesh->write(probname, cycle, time,
@@ -160,6 +308,406 @@ void Driver::run() {
 }
 
 
+void Driver::tuneChunks() {
+
+    using Parallel::mype;
+
+    // default candidates:  one chunk, and powers of two up to
+    // the largest mesh on any PE
+    vector<double> cands(chunkcands);
+    if (cands.empty()) {
+        double maxsize = max(mesh->nump, mesh->nums);
+        Parallel::globalMax(maxsize);
+        cands.push_back(0.);
+        for (int cs = 64; cs < maxsize && cs <= 65536; cs *= 2)
+            cands.push_back(cs);
+    }
+
+    // save everything that changes during a cycle
+    ChkptWriter snap;
+    mesh->writeState(snap);
+    hydro->writeChkpt(snap);
+    vector<char> snapbuf;
+    snap.stage(snapbuf);
+    const double time0 = time;
+    const int cycle0 = cycle;
+    const double dt0 = dt;
+    const double dtlast0 = dtlast;
+    const string msgdt0 = msgdt;
+    const string msgdtlast0 = msgdtlast;
+
+    // time each candidate, from the same starting state;
+    // the best cycle is used, since the first one after a
+    // change of chunks may run cold
+    vector<double> ctime(cands.size());
+    int best = 0;
+    for (int i = 0; i < cands.size(); ++i) {
+        mesh->setChunkSize((int) cands[i]);
+        for (int b = 0; b < hydro->bcs.size(); ++b)
+            hydro->bcs[b]->initChunks();
+
+        double tmin = 1.e99;
+        for (int k = 0; k < chunktunecycles; ++k) {
+            double t0 = Timer::now();
+            cycle += 1;
+            calcGlobalDt();
+            hydro->doCycle(dt);
+            time += dt;
+            double t = Timer::now() - t0;
+            Parallel::globalMax(t);
+            tmin = min(tmin, t);
+        }
+        ctime[i] = tmin;
+        if (ctime[i] < ctime[best]) best = i;
+
+        snap.restore();
+        time = time0;
+        cycle = cycle0;
+        dt = dt0;
+        dtlast = dtlast0;
+        msgdt = msgdt0;
+        msgdtlast = msgdtlast0;
+    }
+
+    mesh->setChunkSize((int) cands[best]);
+    for (int b = 0; b < hydro->bcs.size(); ++b)
+        hydro->bcs[b]->initChunks();
+
+    // the arrays' pages follow the chunks
+    mesh->placeArrays();
+    hydro->placeArrays();
+
+    // tuning cycles don't count in the phase timings
+    timer->reset();
+
+    if (mype == 0 && !quiet) {
+        cout << "--- Chunksize tuning (" << chunktunecycles
+             << " cycles each) ---" << endl;
+        cout << scientific << setprecision(4);
+        for (int i = 0; i < cands.size(); ++i) {
+            cout << "chunksize " << setw(6) << (int) cands[i]
+                 << ":  " << ctime[i] << " s/cycle";
+            if (i == best) cout << "  <-- chosen";
+            cout << endl;
+        }
+        cout << "------------------------" << endl;
+    }
+
+}
+
+
+void Driver::writeBench() {
+
+    using Parallel::numpe;
+    using Parallel::mype;
+
+    // a cycle takes as long as its slowest PE
+    const int n = cyctime.size();
+    vector<double> t(cyctime);
+    for (int i = 0; i < n; ++i)
+        Parallel::globalMax(t[i]);
+
+    // peak resident set size, in MB
+    double rss = Memory::getPeakRSS() * 1.e-6;
+    double rssmax = rss;
+    Parallel::globalSum(rss);
+    Parallel::globalMax(rssmax);
+
+    // memory on huge pages, in MB, and data TLB misses, to compare
+    // runs with different hugepages settings
+    double thpbytes, hugetlbbytes;
+    int64_t numfallback;
+    Memory::getPageStats(thpbytes, hugetlbbytes, numfallback);
+    Parallel::globalSum(thpbytes);
+    Parallel::globalSum(hugetlbbytes);
+    Parallel::globalSum(numfallback);
+    double tlbmiss = 0.;
+    bool tlbavail = (timer->perf != NULL &&
+            timer->perf->getTotal(PerfCounters::EV_DTLBMISS, tlbmiss));
+
+    if (mype > 0 || quiet || n == 0) return;
+
+    double sum = 0.;
+    for (int i = 0; i < n; ++i)
+        sum += t[i];
+    const double mean = sum / n;
+    double ssq = 0.;
+    for (int i = 0; i < n; ++i)
+        ssq += (t[i] - mean) * (t[i] - mean);
+    const double stddev = (n > 1 ? sqrt(ssq / (n - 1)) : 0.);
+
+    // percentiles by nearest rank
+    sort(t.begin(), t.end());
+    const double pct[] = { 0., 5., 25., 50., 75., 95., 100. };
+    const int numpct = sizeof(pct) / sizeof(pct[0]);
+    double tpct[numpct];
+    for (int i = 0; i < numpct; ++i) {
+        int k = (int) ceil(pct[i] / 100. * n) - 1;
+        tpct[i] = t[max(k, 0)];
+    }
+    const double median = (n % 2 == 1 ? t[n / 2] :
+            0.5 * (t[n / 2 - 1] + t[n / 2]));
+    const double gnumz = mesh->gnumz;
+
+    cout << endl;
+    cout << "--- Benchmark (" << n << " cycles after "
+         << benchwarmup << " warm-up) ---" << endl;
+    cout << scientific << setprecision(5);
+    cout << "cycle time median:  " << median << endl;
+    cout << "cycle time mean:    " << mean << endl;
+    cout << "cycle time stddev:  " << stddev
+         << "  (" << fixed << setprecision(2)
+         << 100. * stddev / mean << "% of mean)" << endl;
+    cout << scientific << setprecision(5);
+    cout << "percentiles:";
+    for (int i = 0; i < numpct; ++i)
+        cout << "  p" << (int) pct[i] << " = " << tpct[i];
+    cout << endl;
+    cout << "zone-cycles/s (median):  " << gnumz / median << endl;
+    cout << "zone-cycles/s (mean):    " << gnumz / mean << endl;
+    cout << fixed << setprecision(1);
+    cout << "peak RSS (MB):  " << rssmax << " max/PE, "
+         << rss << " total over " << numpe << " PE(s)" << endl;
+    cout << "huge pages (" << Memory::policyName(Memory::getPolicy())
+         << "):  " << thpbytes * 1.e-6 << " MB transparent, "
+         << hugetlbbytes * 1.e-6 << " MB from pool";
+    if (numfallback > 0)
+        cout << " (" << numfallback << " array(s) fell back to thp)";
+    cout << endl;
+    cout << scientific << setprecision(5);
+    if (tlbavail)
+        cout << "dTLB misses per zone-cycle:  "
+             << tlbmiss / (gnumz * n) << endl;
+    else
+        cout << "dTLB misses per zone-cycle:  n/a (no hardware counters)"
+             << endl;
+    cout << "------------------------" << endl;
+
+}
+
+
+void Driver::writeScratch() {
+
+    int64_t numarena, numheap;
+    double maxbytes;
+    Memory::getScratchStats(numarena, numheap, maxbytes);
+    Parallel::globalSum(numarena);
+    Parallel::globalSum(numheap);
+    Parallel::globalMax(maxbytes);
+
+    if (Parallel::mype > 0) return;
+
+    cout << endl;
+    cout << "--- Scratch arrays ---" << endl;
+    cout << "from arenas:  " << numarena << endl;
+    cout << "from malloc:  " << numheap << endl;
+    cout << scientific << setprecision(4);
+    cout << "largest arena (bytes):  " << maxbytes << endl;
+    cout << "------------------------" << endl;
+
+}
+
+
+namespace {
+
+// order fields by decreasing peak memory
+bool morePeak(const Memory::Usage& a, const Memory::Usage& b) {
+    return a.peak > b.peak;
+}
+
+}  // namespace
+
+
+void Driver::writeMemory() {
+
+    using Parallel::numpe;
+
+    vector<Memory::Usage> fields;
+    Memory::Usage total;
+    Memory::getUsage(fields, total);
+
+    // field names may differ between PEs, so only totals are
+    // combined; the table is for PE 0
+    double gbytes = total.bytes;
+    double bytesmax = total.bytes;
+    double rss = Memory::getPeakRSS() * 1.e-6;
+    double rssmin = rss, rssmax = rss;
+    double leanbytes = mesh->leanbytes;
+    Parallel::globalSum(gbytes);
+    Parallel::globalMax(bytesmax);
+    Parallel::globalSum(leanbytes);
+    Parallel::globalSum(rss);
+    Parallel::globalMin(rssmin);
+    Parallel::globalMax(rssmax);
+
+    if (Parallel::mype > 0) return;
+
+    stable_sort(fields.begin(), fields.end(), morePeak);
+    fields.push_back(total);
+    const double numz = max(mesh->numz, 1);
+    const double gnumz = max(mesh->gnumz, (int64_t) 1);
+
+    cout << endl;
+    cout << "--- Memory by field (PE 0) ---" << endl;
+    cout << setw(20) << left << "field" << right
+         << setw(8) << "arrays" << setw(12) << "MB"
+         << setw(12) << "bytes/zone" << setw(12) << "peak MB" << endl;
+    cout << fixed;
+    for (int i = 0; i < (int) fields.size(); ++i) {
+        const Memory::Usage& u = fields[i];
+        cout << setw(20) << left << u.name << right
+             << setw(8) << u.numarrays
+             << setprecision(3) << setw(12) << u.bytes * 1.e-6
+             << setprecision(1) << setw(12) << u.bytes / numz
+             << setprecision(3) << setw(12) << u.peak * 1.e-6 << endl;
+    }
+    cout << setprecision(1);
+    cout << "all PEs (MB):  " << gbytes * 1.e-6 << " total, "
+         << bytesmax * 1.e-6 << " max/PE, " << gbytes / gnumz
+         << " bytes/zone" << endl;
+    if (mesh->leanmem)
+        cout << "not stored (leanmem) (MB):  " << leanbytes * 1.e-6
+             << ", " << leanbytes / gnumz << " bytes/zone ("
+             << 100. * leanbytes / (gbytes + leanbytes)
+             << "%)" << endl;
+    cout << "peak RSS per PE (MB):  " << rssmin << " min, "
+         << rss / numpe << " avg, " << rssmax << " max/PE" << endl;
+    cout << "------------------------" << endl;
+
+}
+
+
+void Driver::initFromChkpt(ChkptReader& cr) {
+
+    char cmsgdt[80], cmsgdtlast[80];
+    cr.read("time", time);
+    cr.read("cycle", cycle);
+    cr.read("dt", dt);
+    cr.read("dtlast", dtlast);
+    cr.read("msgdt", cmsgdt, 80);
+    cr.read("msgdtlast", cmsgdtlast, 80);
+    cmsgdt[79] = '\0';
+    cmsgdtlast[79] = '\0';
+    msgdt = string(cmsgdt);
+    msgdtlast = string(cmsgdtlast);
+
+    if (Parallel::mype == 0 && !quiet) {
+        cout << scientific << setprecision(5);
+        cout << "Restart at cycle " << cycle
+             << ", time = " << time << endl;
+    }
+
+}
+
+
+void Driver::writeChkpt() {
+
+    using Parallel::mype;
+
+    double t0 = Timer::now();
+
+    ostringstream oss;
+    oss << probname << ".chk" << setw(6) << setfill('0') << cycle;
+    const string basename = oss.str();
+
+    ChkptWriter cw;
+    mesh->writeChkpt(cw);
+    hydro->writeChkpt(cw);
+
+    // driver state goes last, in the same order as initFromChkpt
+    char cmsgdt[80], cmsgdtlast[80];
+    memset(cmsgdt, 0, 80);
+    memset(cmsgdtlast, 0, 80);
+    msgdt.copy(cmsgdt, 79);
+    msgdtlast.copy(cmsgdtlast, 79);
+    cw.add("time", time);
+    cw.add("cycle", cycle);
+    cw.add("dt", dt);
+    cw.add("dtlast", dtlast);
+    cw.add("msgdt", cmsgdt, 80);
+    cw.add("msgdtlast", cmsgdtlast, 80);
+
+    const string fname = Checkpoint::fileName(basename, mype);
+    double bytes = cw.size();
+    Parallel::globalSum(bytes);
+
+    if (chkthread) {
+        // the previous write must finish before the staging
+        // buffer can be reused
+        checkChkpt(chkthread->wait());
+        chkthread->submit(cw, fname);
+        double tchk = Timer::now() - t0;
+        Parallel::globalMax(tchk);
+        if (mype == 0 && !quiet) {
+            cout << scientific << setprecision(5);
+            cout << "Staged checkpoint " << basename
+                 << ", " << setw(11) << bytes * 1.e-6 << " MB"
+                 << ", wall = " << setw(11) << tchk << endl;
+        }
+        return;
+    }
+
+    checkChkpt(cw.write(fname));
+    double tchk = Timer::now() - t0;
+    Parallel::globalMax(tchk);
+    if (mype == 0 && !quiet) {
+        cout << scientific << setprecision(5);
+        cout << "Wrote checkpoint " << basename
+             << ", " << setw(11) << bytes * 1.e-6 << " MB"
+             << ", wall = " << setw(11) << tchk << endl;
+    }
+
+}
+
+
+void Driver::checkChkpt(const bool ok) {
+
+    double pok = (ok ? 1. : 0.);
+    Parallel::globalMin(pok);
+    if (pok == 0.) {
+        if (Parallel::mype == 0)
+            cerr << "Error writing checkpoint" << endl;
+        exit(1);
+    }
+
+}
+
+
+void Driver::finishChkpt() {
+
+    using Parallel::mype;
+
+    checkChkpt(chkthread->wait());
+
+    // time spent writing that wasn't waited for was hidden
+    // behind the hydro cycle
+    double tstage = chkthread->tstage;
+    double twait = chkthread->twait;
+    double twrite = chkthread->twrite;
+    double thidden = max(twrite - twait, 0.);
+    double stagemb = chkthread->stagebuf.size() * 1.e-6;
+    Parallel::globalMax(tstage);
+    Parallel::globalMax(twait);
+    Parallel::globalMax(twrite);
+    Parallel::globalMin(thidden);
+    Parallel::globalMax(stagemb);
+
+    if (mype == 0 && !quiet) {
+        cout << endl;
+        cout << "--- Async checkpoint I/O (max over PEs) ---" << endl;
+        cout << scientific << setprecision(4);
+        cout << "checkpoints written:   " << chkthread->numwrites << endl;
+        cout << "staging buffer (MB):   " << stagemb << endl;
+        cout << "write time:            " << twrite << endl;
+        cout << "exposed, staging copy: " << tstage << endl;
+        cout << "exposed, I/O wait:     " << twait << endl;
+        cout << "hidden (min over PEs): " << thidden << endl;
+        cout << "------------------------" << endl;
+    }
+
+}
+
+
 void Driver::calcGlobalDt() {
 
     using Parallel::mype;
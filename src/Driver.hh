@@ -14,21 +14,32 @@
 #define DRIVER_HH_
 
 #include <string>
+#include <vector>
 
 // forward declarations
 class InputFile;
 class Mesh;
 class Hydro;
+class Timer;
+class Roofline;
+class ChkptReader;
+class ChkptThread;
 
 
 class Driver {
 public:
 
     // children of this object
+    Timer *timer;
     Mesh *mesh;
     Hydro *hydro;
+    Roofline *roofline;            // (NULL if not in use)
+    ChkptThread *chkthread;        // background checkpoint writer
+                                   // (NULL if not in use)
 
     std::string probname;          // problem name
+    bool quiet;                    // flag:  suppress all output
+                                   // except errors?
     double time;                   // simulation time
     int cycle;                     // simulation cycle number
     double tstop;                  // simulation stop time
@@ -41,13 +52,68 @@ public:
     double dtlast;                 // previous timestep
     std::string msgdt;             // dt limiter message
     std::string msgdtlast;         // previous dt limiter message
+    int chkptcycles;               // cycles between checkpoints
+                                   // (0 = never)
+    double chkptwall;              // wall-clock seconds between
+                                   // checkpoints (0 = never)
+    int benchcycles;               // cycles to time in benchmark
+                                   // mode (0 = not benchmarking)
+    int benchwarmup;               // untimed cycles before benchmark
+    std::vector<double> cyctime;   // benchmark time for each cycle
+    std::vector<double> chunkcands;
+                                   // candidates for chunksize auto
+    int chunktunecycles;           // cycles to time per candidate
+    double tbegin, tlast;          // wall-clock time at start,
+                                   // at last cycle report
+    double tchkpt;                 // wall-clock time of last checkpoint
+    int cyclebegin;                // cycle at start of run
+    int cycle0;                    // first cycle counted in timings
 
     Driver(const InputFile* inp, const std::string& pname);
     ~Driver();
 
+    // run to completion:  start, step until done, finish
     void run();
+
+    // begin run:  initial energy check and chunk tuning
+    void start();
+
+    // has the run reached cstop or tstop?
+    bool done() const;
+
+    // advance one cycle, with reports and checkpoints as needed
+    void step();
+
+    // end run:  final reports and mesh output
+    void finish();
+
     void calcGlobalDt();
 
+    // time a few cycles with each candidate chunksize, then
+    // restore the initial state and keep the fastest
+    void tuneChunks();
+
+    // write benchmark statistics
+    void writeBench();
+
+    // write counts of scratch arrays taken from arenas and malloc
+    void writeScratch();
+
+    // write memory held by each field, and peak RSS
+    void writeMemory();
+
+    // restore driver state from checkpoint
+    void initFromChkpt(ChkptReader& cr);
+
+    // write checkpoint files for the current cycle
+    void writeChkpt();
+
+    // exit if a checkpoint write failed on any PE
+    void checkChkpt(const bool ok);
+
+    // wait for background checkpoint writes, and report timing
+    void finishChkpt();
+
 };  // class Driver
 
 
@@ -0,0 +1,284 @@
+/*
+ * Ensemble.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Ensemble.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+#include "Parallel.hh"
+#include "Driver.hh"
+#include "Mesh.hh"
+#include "Hydro.hh"
+#include "HydroLanes.hh"
+#include "Timer.hh"
+
+using namespace std;
+
+
+const string Ensemble::sweepprefix = "sweep_";
+
+
+Ensemble::Ensemble(const int numfiles, const char* const* filenames) {
+
+    using Parallel::numpe;
+    using Parallel::mype;
+
+    if (numpe > 1) {
+        if (mype == 0)
+            cerr << "Error: ensemble mode runs on a single PE" << endl;
+        exit(1);
+    }
+
+    for (int i = 0; i < numfiles; ++i) {
+        InputFile inp(filenames[i]);
+        addCases(inp, probName(filenames[i]));
+    }
+    sumname = probName(filenames[0]) + ".ensemble.csv";
+
+}
+
+
+Ensemble::~Ensemble() {}
+
+
+bool Ensemble::hasSweep(const InputFile& inp) {
+    return !inp.getKeys(sweepprefix).empty();
+}
+
+
+string Ensemble::probName(const string& filename) {
+    string probname(filename);
+    int len = probname.length();
+    if (len >= 4 && probname.substr(len - 4, 4) == ".pnt")
+        probname = probname.substr(0, len - 4);
+    return probname;
+}
+
+
+void Ensemble::addCases(const InputFile& inp, const string& pname) {
+
+    // get list of values for each swept key
+    vector<string> sweepkeys = inp.getKeys(sweepprefix);
+    const int numkeys = sweepkeys.size();
+    vector<string> keys(numkeys);
+    vector<vector<string> > vals(numkeys);
+    int numcomb = 1;
+    for (int k = 0; k < numkeys; ++k) {
+        keys[k] = sweepkeys[k].substr(sweepprefix.size());
+        vals[k] = inp.getStringList(sweepkeys[k], vector<string>());
+        if (vals[k].empty()) {
+            cerr << "Error: no values for " << sweepkeys[k] << endl;
+            exit(1);
+        }
+        numcomb *= vals[k].size();
+    }
+
+    // one case for each combination of values, with the
+    // last key varying fastest
+    for (int c = 0; c < numcomb; ++c) {
+        Case cs(inp);
+        cs.inp.set("quiet", "1");
+        cs.name = pname;
+        if (numkeys > 0) {
+            ostringstream oss;
+            oss << pname << "_" << setw(4) << setfill('0') << c;
+            cs.name = oss.str();
+        }
+        int rem = c;
+        for (int k = numkeys - 1; k >= 0; --k) {
+            const string& v = vals[k][rem % vals[k].size()];
+            rem /= vals[k].size();
+            cs.inp.set(keys[k], v);
+            cs.params = keys[k] + "=" + v +
+                    (cs.params.empty() ? "" : " ") + cs.params;
+        }
+        cases.push_back(cs);
+    }
+
+}
+
+
+void Ensemble::run() {
+
+    const int numcase = cases.size();
+    results.resize(numcase);
+
+    // consecutive problems that share a mesh and ask for the same
+    // lane width run together in one group
+    vector<vector<int> > groups;
+    for (int i = 0; i < numcase; ++i) {
+        const InputFile& inp = cases[i].inp;
+        const int width = inp.getInt("ensemblewidth", 1);
+        if (width != 1 && !HydroLanesBase::validWidth(width)) {
+            cerr << "Error: bad ensemblewidth " << width << " for "
+                 << cases[i].name << endl;
+            exit(1);
+        }
+        if (width > 1 && !groups.empty()) {
+            vector<int>& g = groups.back();
+            const InputFile& inp0 = cases[g[0]].inp;
+            if (g.size() < width &&
+                    inp0.getInt("ensemblewidth", 1) == width &&
+                    HydroLanesBase::sameMesh(inp0, inp)) {
+                g.push_back(i);
+                continue;
+            }
+        }
+        groups.push_back(vector<int>(1, i));
+    }
+    const int numgrp = groups.size();
+
+    // the memory policy is process-wide, so it is set once here,
+    // before the problems' meshes are built on the team's threads
+    const InputFile& inp0 = cases[0].inp;
+    const int memalign = inp0.getInt("memalign", 64);
+    const string pages = inp0.getString("hugepages", "none");
+    for (int i = 1; i < numcase; ++i) {
+        const InputFile& inp = cases[i].inp;
+        if (inp.getInt("memalign", 64) != memalign ||
+                inp.getString("hugepages", "none") != pages) {
+            cerr << "Error: memalign and hugepages must be the same "
+                 << "for all problems in an ensemble (" << cases[i].name
+                 << ")" << endl;
+            exit(1);
+        }
+    }
+    Mesh::setMemPolicy(&inp0);
+
+    int numthr = 1;
+#ifdef _OPENMP
+    numthr = omp_get_max_threads();
+    // each problem runs on a single thread
+    omp_set_max_active_levels(1);
+#endif
+
+    cout << "********************" << endl;
+    cout << "Running PENNANT v0.9" << endl;
+    cout << "********************" << endl;
+    cout << endl;
+    cout << "Running ensemble of " << numcase << " problem(s) ";
+    if (numgrp < numcase)
+        cout << "in " << numgrp << " group(s) ";
+    cout << "on " << numthr << " thread(s)" << endl;
+
+    double tbegin = Timer::now();
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int g = 0; g < numgrp; ++g) {
+        runGroup(groups[g]);
+    }
+
+    double wall = Timer::now() - tbegin;
+    write(wall, numthr);
+
+}
+
+
+void Ensemble::runGroup(const vector<int>& grp) {
+
+    const int width = cases[grp[0]].inp.getInt("ensemblewidth", 1);
+    const int numg = grp.size();
+    int thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    double t0 = Timer::now();
+
+    if (width == 1) {
+        const int i = grp[0];
+        Driver drv(&cases[i].inp, cases[i].name);
+        drv.run();
+
+        Result& r = results[i];
+        r.zones = drv.mesh->gnumz;
+        r.cycle = drv.cycle;
+        r.time = drv.time;
+        drv.hydro->calcEnergyCheck(r.ei, r.ek);
+        r.runtime = Timer::now() - t0;
+        r.lanes = 1;
+        r.thread = thread;
+        return;
+    }
+
+    vector<const InputFile*> inps(numg);
+    vector<string> names(numg);
+    for (int j = 0; j < numg; ++j) {
+        inps[j] = &cases[grp[j]].inp;
+        names[j] = cases[grp[j]].name;
+    }
+    HydroLanesBase* hl = HydroLanesBase::create(width, inps, names);
+    hl->run();
+    const int64_t zones = hl->zones();
+
+    // the group's run time is shared among its problems
+    double runtime = (Timer::now() - t0) / numg;
+    for (int j = 0; j < numg; ++j) {
+        const HydroLanesBase::Result& hr = hl->results[j];
+        Result& r = results[grp[j]];
+        r.zones = zones;
+        r.cycle = hr.cycle;
+        r.time = hr.time;
+        r.ei = hr.ei;
+        r.ek = hr.ek;
+        r.runtime = runtime;
+        r.lanes = width;
+        r.thread = thread;
+    }
+    delete hl;
+
+}
+
+
+void Ensemble::write(const double wall, const int numthr) {
+
+    const int numcase = cases.size();
+
+    ofstream ofs(sumname.c_str());
+    if (!ofs.good()) {
+        cerr << "Cannot open file " << sumname << " for writing" << endl;
+        exit(1);
+    }
+    ofs << "problem,params,zones,cycle,time,etot,ei,ek,runtime,"
+        << "lanes,thread" << endl;
+    double tsum = 0.;
+    int64_t zcsum = 0;
+    for (int i = 0; i < numcase; ++i) {
+        const Result& r = results[i];
+        ofs << cases[i].name << "," << cases[i].params << ","
+            << r.zones << "," << r.cycle << ",";
+        ofs << scientific << setprecision(6);
+        ofs << r.time << "," << r.ei + r.ek << "," << r.ei << ","
+            << r.ek << "," << r.runtime << "," << r.lanes << ","
+            << r.thread << endl;
+        tsum += r.runtime;
+        zcsum += r.zones * r.cycle;
+    }
+    ofs.close();
+
+    cout << endl;
+    cout << "Ensemble complete" << endl;
+    cout << scientific << setprecision(6);
+    cout << "problems:             " << numcase << endl;
+    cout << "wall time:            " << wall << endl;
+    cout << "problems/hour:        " << numcase / wall * 3600. << endl;
+    cout << "zone-cycles/s:        " << zcsum / wall << endl;
+    cout << "thread utilization:   " << fixed << setprecision(1)
+         << 100. * tsum / (wall * numthr) << "%" << endl;
+    cout << "Results written to " << sumname << endl;
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Ensemble.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef ENSEMBLE_HH_
+#define ENSEMBLE_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "InputFile.hh"
+
+
+// Class Ensemble runs many independent problems in one process,
+// one problem per thread, with each problem running serially.
+// The problems come from a list of input files, each of which
+// may also define a parameter sweep:  a key of the form
+// sweep_<key> gives a list of values for <key>, and one problem
+// is run for each combination of values of all swept keys.
+// Consecutive problems that share a mesh may also run together as
+// the lanes of one HydroLanes group (see input key ensemblewidth).
+// Results are written to a summary file.
+
+class Ensemble {
+public:
+
+    // one problem in the ensemble
+    struct Case {
+        InputFile inp;             // input parameters
+        std::string name;          // problem name
+        std::string params;        // swept parameter values
+        Case(const InputFile& i) : inp(i) {}
+    };
+
+    // results for one problem
+    struct Result {
+        int64_t zones;             // number of zones
+        int cycle;                 // final cycle
+        double time;               // final simulation time
+        double ei, ek;             // final internal, kinetic energy
+        double runtime;            // wall-clock run time
+        int lanes;                 // lane width of problem's group
+        int thread;                // thread that ran the problem
+    };
+
+    static const std::string sweepprefix;
+
+    std::vector<Case> cases;       // problems to run
+    std::vector<Result> results;   // results, in same order as cases
+    std::string sumname;           // name of summary file
+
+    Ensemble(const int numfiles, const char* const* filenames);
+    ~Ensemble();
+
+    // does an input file define a parameter sweep?
+    static bool hasSweep(const InputFile& inp);
+
+    // strip .pnt suffix from filename
+    static std::string probName(const std::string& filename);
+
+    // add the problems for one input file
+    void addCases(const InputFile& inp, const std::string& pname);
+
+    void run();
+
+    // run one group of problems:  a single problem, or problems
+    // run together in lanes
+    void runGroup(const std::vector<int>& grp);
+
+    // write summary file
+    void write(const double wall, const int numthr);
+
+};  // class Ensemble
+
+
+#endif /* ENSEMBLE_HH_ */
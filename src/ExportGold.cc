@@ -121,7 +121,10 @@ void ExportGold::writeGeoFile(
 
     // gather node info to PE 0
     const int nump = mesh->nump;
-    const double2* px = mesh->px;
+    const_double2ptr mpx = mesh->px;
+    vector<double2> px(nump);
+    for (int p = 0; p < nump; ++p)
+        px[p] = mpx[p];
 
     int gnump = nump;
     Parallel::globalSum(gnump);
@@ -0,0 +1,82 @@
+/*
+ * FieldTypes.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef FIELDTYPES_HH_
+#define FIELDTYPES_HH_
+
+#include "Vec2Array.hh"
+#include "VecW.hh"
+#include "Memory.hh"
+
+
+// The kernels in Mesh, Hydro, HydroBC, QCS, PolyGas and TTS are
+// templates on a field types class, as well as on a side map class
+// (see SideMap.hh).  The field types class gives the types of the
+// values and arrays a kernel works on:
+//     real, real2         scalar and vector value at an element
+//     index               element number, as found by a search
+//     ptr, cptr           scalar array, read-only scalar array
+//     ptr2, cptr2         vector array, read-only vector array
+//     scratch(n)          scratch array of n real values
+//     scratch2(n)         scratch array of n real2 values
+// Problem parameters used by a kernel, such as the time step, are
+// passed to it as real values.  FieldsOne runs one problem, and
+// the kernel's plain version uses it.  FieldsLanes<W> runs the W
+// problems of a HydroLanes group at once, with the types of
+// VecW.hh.  Mesh connectivity and the side mass fractions (smf)
+// are the same in every lane, so they stay int and double arrays.
+
+struct FieldsOne {
+    typedef double real;
+    typedef double2 real2;
+    typedef int index;
+    typedef double* ptr;
+    typedef const double* cptr;
+    typedef double2ptr ptr2;
+    typedef const_double2ptr cptr2;
+
+    static ptr scratch(const int n) { return Memory::scratch<double>(n); }
+    static ptr2 scratch2(const int n) { return Memory::scratch2(n); }
+};
+
+
+template <int W>
+struct FieldsLanes {
+    typedef doubleW<W> real;
+    typedef double2W<W> real2;
+    typedef intW<W> index;
+    typedef real* ptr;
+    typedef const real* cptr;
+    typedef real2* ptr2;
+    typedef const real2* cptr2;
+
+    static ptr scratch(const int n) { return Memory::scratch<real>(n); }
+    static ptr2 scratch2(const int n) { return Memory::scratch<real2>(n); }
+};
+
+
+// Kernels are defined in the .cc file of their class, and explicitly
+// instantiated there for the lane widths HydroLanes supports;
+// FOR_EACH_LANES(M) expands M(FT) for each FieldsLanes class, and
+// FOR_EACH_LANES_SM(M) expands M(FT, SM) for each pairing of one
+// with a side map class (see FOR_EACH_SIDEMAP in SideMap.hh).
+#define FOR_EACH_LANES(M) \
+    M(FieldsLanes<2>) \
+    M(FieldsLanes<4>) \
+    M(FieldsLanes<8>)
+
+#define FOR_EACH_LANES_SM(M) \
+    FOR_EACH_SIDEMAP(M, FieldsLanes<2>) \
+    FOR_EACH_SIDEMAP(M, FieldsLanes<4>) \
+    FOR_EACH_SIDEMAP(M, FieldsLanes<8>)
+
+
+#endif /* FIELDTYPES_HH_ */
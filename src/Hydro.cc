@@ -25,15 +25,147 @@
 #include "Memory.hh"
 #include "InputFile.hh"
 #include "Mesh.hh"
+#include "SideMap.hh"
 #include "PolyGas.hh"
 #include "TTS.hh"
 #include "QCS.hh"
 #include "HydroBC.hh"
+#include "Timer.hh"
+#include "Checkpoint.hh"
 
 using namespace std;
 
 
-Hydro::Hydro(const InputFile* inp, Mesh* m) : mesh(m) {
+namespace {
+
+// function objects for dispatchSideMap (see SideMap.hh):  each
+// calls a kernel's FieldsOne version with the side map given
+
+struct CalcCrnrMassOp {
+    const double* zr;
+    const double* zarea;
+    const double* smf;
+    double* cmaswt;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::calcCrnrMass<FieldsOne>(sm, zr, zarea, smf, cmaswt, sfirst,
+                slast);
+    }
+};
+
+
+struct SumCrnrForceOp {
+    const_double2ptr sf;
+    const_double2ptr sf2;
+    const_double2ptr sf3;
+    double2ptr cftot;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::sumCrnrForce<FieldsOne>(sm, sf, sf2, sf3, cftot, sfirst, slast);
+    }
+};
+
+
+struct CalcCrnrForceFusedOp {
+    double alfa;
+    double ssmin;
+    const double* zp;
+    const double* zareap;
+    const double* zrp;
+    const double* zss;
+    const double* sareap;
+    const double* smf;
+    const_double2ptr ssurfp;
+    double2ptr sfq;
+    double2ptr cftot;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::calcCrnrForceFused<FieldsOne>(sm, alfa, ssmin, zp, zareap, zrp,
+                zss, sareap, smf, ssurfp, sfq, cftot, sfirst, slast);
+    }
+};
+
+
+struct CalcCrnrForceLeanOp {
+    double alfa;
+    double ssmin;
+    const double* zp;
+    const double* zareap;
+    const double* zrp;
+    const double* zss;
+    const double* smf;
+    const_double2ptr pxp;
+    const_double2ptr exp;
+    const_double2ptr zxp;
+    double2ptr sfq;
+    double2ptr cftot;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::calcCrnrForceLean<FieldsOne>(sm, alfa, ssmin, zp, zareap, zrp,
+                zss, smf, pxp, exp, zxp, sfq, cftot, sfirst, slast);
+    }
+};
+
+
+struct CalcWorkOp {
+    const_double2ptr sf;
+    const_double2ptr sf2;
+    const_double2ptr pu0;
+    const_double2ptr pu;
+    const_double2ptr px;
+    double dt;
+    double* zw;
+    double* zetot;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::calcWork<FieldsOne>(sm, sf, sf2, pu0, pu, px, dt, zw, zetot,
+                sfirst, slast);
+    }
+};
+
+
+struct SumEnergyOp {
+    const double* zetot;
+    const double* zarea;
+    const double* zvol;
+    const double* zm;
+    const double* smf;
+    const_double2ptr px;
+    const_double2ptr pu;
+    double& ei;
+    double& ek;
+    int zfirst;
+    int zlast;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        Hydro::sumEnergy<FieldsOne>(sm, zetot, zarea, zvol, zm, smf, px, pu,
+                ei, ek, zfirst, zlast, sfirst, slast);
+    }
+};
+
+}  // namespace
+
+
+Hydro::Hydro(const InputFile* inp, Mesh* m, ChkptReader* cr)
+        : mesh(m) {
     cfl = inp->getDouble("cfl", 0.6);
     cflv = inp->getDouble("cflv", 0.1);
     rinit = inp->getDouble("rinit", 1.);
@@ -43,6 +175,12 @@ Hydro::Hydro(const InputFile* inp, Mesh* m) : mesh(m) {
     uinitradial = inp->getDouble("uinitradial", 0.);
     bcx = inp->getDoubleList("bcx", vector<double>());
     bcy = inp->getDoubleList("bcy", vector<double>());
+    fusedforce = inp->getInt("fusedforce", 1);
+    if (mesh->leanmem && !fusedforce) {
+        if (Parallel::mype == 0)
+            cerr << "Error: leanmem requires fusedforce" << endl;
+        exit(1);
+    }
 
     pgas = new PolyGas(inp, this);
     tts = new TTS(inp, this);
@@ -55,7 +193,10 @@ Hydro::Hydro(const InputFile* inp, Mesh* m) : mesh(m) {
     for (int i = 0; i < bcy.size(); ++i)
         bcs.push_back(new HydroBC(mesh, vfixy, mesh->getYPlane(bcy[i])));
 
-    init();
+    if (cr)
+        initFromChkpt(*cr);
+    else
+        init();
 }
 
 
@@ -73,34 +214,12 @@ void Hydro::init() {
 
     const int numpch = mesh->numpch;
     const int numzch = mesh->numzch;
-    const int nump = mesh->nump;
-    const int numz = mesh->numz;
-    const int nums = mesh->nums;
 
-    const double2* zx = mesh->zx;
+    const_double2ptr zx = mesh->zx;
     const double* zvol = mesh->zvol;
 
     // allocate arrays
-    pu = Memory::alloc<double2>(nump);
-    pu0 = Memory::alloc<double2>(nump);
-    pap = Memory::alloc<double2>(nump);
-    pf = Memory::alloc<double2>(nump);
-    pmaswt = Memory::alloc<double>(nump);
-    cmaswt = Memory::alloc<double>(nums);
-    zm = Memory::alloc<double>(numz);
-    zr = Memory::alloc<double>(numz);
-    zrp = Memory::alloc<double>(numz);
-    ze = Memory::alloc<double>(numz);
-    zetot = Memory::alloc<double>(numz);
-    zw = Memory::alloc<double>(numz);
-    zwrate = Memory::alloc<double>(numz);
-    zp = Memory::alloc<double>(numz);
-    zss = Memory::alloc<double>(numz);
-    zdu = Memory::alloc<double>(numz);
-    sfp = Memory::alloc<double2>(nums);
-    sfq = Memory::alloc<double2>(nums);
-    sft = Memory::alloc<double2>(nums);
-    cftot = Memory::alloc<double2>(nums);
+    initArrays();
 
     // initialize hydro vars
     #pragma omp parallel for schedule(static)
@@ -141,11 +260,117 @@ void Hydro::init() {
         if (uinitradial != 0.)
             initRadialVel(uinitradial, pfirst, plast);
         else
-            fill(&pu[pfirst], &pu[plast], double2(0., 0.));
+            for (int p = pfirst; p < plast; ++p)
+                pu[p] = double2(0., 0.);
     }  // for pch
 
     resetDtHydro();
 
+    placeArrays();
+
+}
+
+
+void Hydro::initArrays() {
+
+    const int nump = mesh->nump;
+    const int numz = mesh->numz;
+    const int nums = mesh->nums;
+
+    pu = Memory::alloc2(nump, "pu");
+    pu0 = Memory::alloc2(nump, "pu0");
+    pap = Memory::alloc2(nump, "pap");
+    pf = Memory::alloc2(nump, "pf");
+    pmaswt = Memory::alloc<double>(nump, "pmaswt");
+    cmaswt = Memory::alloc<double>(nums, "cmaswt");
+    zm = Memory::alloc<double>(numz, "zm");
+    zr = Memory::alloc<double>(numz, "zr");
+    zrp = Memory::alloc<double>(numz, "zrp");
+    ze = Memory::alloc<double>(numz, "ze");
+    zetot = Memory::alloc<double>(numz, "zetot");
+    zw = Memory::alloc<double>(numz, "zw");
+    zwrate = Memory::alloc<double>(numz, "zwrate");
+    zp = Memory::alloc<double>(numz, "zp");
+    zss = Memory::alloc<double>(numz, "zss");
+    zdu = Memory::alloc<double>(numz, "zdu");
+    sfq = Memory::alloc2(nums, "sfq");
+    sfp = double2ptr();
+    sft = double2ptr();
+    if (!fusedforce) {
+        sfp = Memory::alloc2(nums, "sfp");
+        sft = Memory::alloc2(nums, "sft");
+    }
+    cftot = Memory::alloc2(nums, "cftot");
+
+}
+
+
+void Hydro::placeArrays() {
+
+    mesh->place("pu", pu, Mesh::ENT_POINT);
+    mesh->place("pu0", pu0, Mesh::ENT_POINT);
+    mesh->place("pap", pap, Mesh::ENT_POINT);
+    mesh->place("pf", pf, Mesh::ENT_POINT);
+    mesh->place("pmaswt", pmaswt, Mesh::ENT_POINT);
+    mesh->place("cmaswt", cmaswt, Mesh::ENT_SIDE);
+    mesh->place("zm", zm, Mesh::ENT_ZONE);
+    mesh->place("zr", zr, Mesh::ENT_ZONE);
+    mesh->place("zrp", zrp, Mesh::ENT_ZONE);
+    mesh->place("ze", ze, Mesh::ENT_ZONE);
+    mesh->place("zetot", zetot, Mesh::ENT_ZONE);
+    mesh->place("zw", zw, Mesh::ENT_ZONE);
+    mesh->place("zwrate", zwrate, Mesh::ENT_ZONE);
+    mesh->place("zp", zp, Mesh::ENT_ZONE);
+    mesh->place("zss", zss, Mesh::ENT_ZONE);
+    mesh->place("zdu", zdu, Mesh::ENT_ZONE);
+    mesh->place("sfq", sfq, Mesh::ENT_SIDE);
+    mesh->place("sfp", sfp, Mesh::ENT_SIDE);
+    mesh->place("sft", sft, Mesh::ENT_SIDE);
+    mesh->place("cftot", cftot, Mesh::ENT_SIDE);
+
+}
+
+
+void Hydro::initFromChkpt(ChkptReader& cr) {
+
+    const int nump = mesh->nump;
+    const int numz = mesh->numz;
+
+    initArrays();
+
+    cr.read("pu", pu, nump);
+    cr.read("zm", zm, numz);
+    cr.read("zr", zr, numz);
+    cr.read("ze", ze, numz);
+    cr.read("zetot", zetot, numz);
+    cr.read("zwrate", zwrate, numz);
+    cr.read("zp", zp, numz);
+    cr.read("zss", zss, numz);
+    cr.read("dtrec", dtrec);
+    cr.read("msgdtrec", msgdtrec, 80);
+
+    placeArrays();
+
+}
+
+
+void Hydro::writeChkpt(ChkptWriter& cw) {
+
+    const int nump = mesh->nump;
+    const int numz = mesh->numz;
+
+    // must stay in the same order as initFromChkpt
+    cw.add("pu", pu, nump);
+    cw.add("zm", zm, numz);
+    cw.add("zr", zr, numz);
+    cw.add("ze", ze, numz);
+    cw.add("zetot", zetot, numz);
+    cw.add("zwrate", zwrate, numz);
+    cw.add("zp", zp, numz);
+    cw.add("zss", zss, numz);
+    cw.add("dtrec", dtrec);
+    cw.add("msgdtrec", msgdtrec, 80);
+
 }
 
 
@@ -153,7 +378,7 @@ void Hydro::initRadialVel(
         const double vel,
         const int pfirst,
         const int plast) {
-    const double2* px = mesh->px;
+    const_double2ptr px = mesh->px;
     const double eps = 1.e-12;
 
     #pragma ivdep
@@ -172,9 +397,9 @@ void Hydro::doCycle(
 
     const int numpch = mesh->numpch;
     const int numsch = mesh->numsch;
-    double2* px = mesh->px;
-    double2* ex = mesh->ex;
-    double2* zx = mesh->zx;
+    double2ptr px = mesh->px;
+    double2ptr ex = mesh->ex;
+    double2ptr zx = mesh->zx;
     double* sarea = mesh->sarea;
     double* svol = mesh->svol;
     double* zarea = mesh->zarea;
@@ -184,28 +409,33 @@ void Hydro::doCycle(
     double* zareap = mesh->zareap;
     double* zvolp = mesh->zvolp;
     double* zvol0 = mesh->zvol0;
-    double2* ssurfp = mesh->ssurfp;
+    double2ptr ssurfp = mesh->ssurfp;
     double* elen = mesh->elen;
-    double2* px0 = mesh->px0;
-    double2* pxp = mesh->pxp;
-    double2* exp = mesh->exp;
-    double2* zxp = mesh->zxp;
+    double2ptr px0 = mesh->px0;
+    double2ptr pxp = mesh->pxp;
+    double2ptr exp = mesh->exp;
+    double2ptr zxp = mesh->zxp;
     double* smf = mesh->smf;
     double* zdl = mesh->zdl;
+    Timer* timer = mesh->timer;
 
     // Begin hydro cycle
     #pragma omp parallel for schedule(static)
     for (int pch = 0; pch < numpch; ++pch) {
         int pfirst = mesh->pchpfirst[pch];
         int plast = mesh->pchplast[pch];
+        double t0 = timer->start();
 
         // save off point variable values from previous cycle
-        copy(&px[pfirst], &px[plast], &px0[pfirst]);
-        copy(&pu[pfirst], &pu[plast], &pu0[pfirst]);
+        for (int p = pfirst; p < plast; ++p) {
+            px0[p] = px[p];
+            pu0[p] = pu[p];
+        }
 
         // ===== Predictor step =====
         // 1. advance mesh to center of time step
         advPosHalf(px0, pu0, dt, pxp, pfirst, plast);
+        timer->lap(Timer::PH_PREDPT, t0);
     } // for pch
 
     #pragma omp parallel for schedule(static)
@@ -214,32 +444,61 @@ void Hydro::doCycle(
         int slast = mesh->schslast[sch];
         int zfirst = mesh->schzfirst[sch];
         int zlast = mesh->schzlast[sch];
+        double t0 = timer->start();
 
         // save off zone variable values from previous cycle
         copy(&zvol[zfirst], &zvol[zlast], &zvol0[zfirst]);
 
         // 1a. compute new mesh geometry
-        mesh->calcCtrs(pxp, exp, zxp, sfirst, slast);
-        mesh->calcVols(pxp, zxp, sareap, svolp, zareap, zvolp,
-                sfirst, slast);
-        mesh->calcSurfVecs(zxp, exp, ssurfp, sfirst, slast);
-        mesh->calcEdgeLen(pxp, elen, sfirst, slast);
-        mesh->calcCharLen(sareap, zdl, sfirst, slast);
+        if (mesh->leanmem) {
+            mesh->calcGeomLean(pxp, exp, zxp, zareap, zvolp, elen, zdl,
+                    sfirst, slast);
+        } else if (mesh->fusedgeom) {
+            mesh->calcGeomFused(pxp, exp, zxp, sareap, svolp,
+                    zareap, zvolp, ssurfp, elen, zdl, sfirst, slast);
+        } else {
+            mesh->calcCtrs(pxp, exp, zxp, sfirst, slast);
+            t0 = timer->lap(Timer::PH_PREDCTRS, t0);
+            mesh->calcVols(pxp, zxp, sareap, svolp, zareap, zvolp,
+                    sfirst, slast);
+            t0 = timer->lap(Timer::PH_PREDVOLS, t0);
+            mesh->calcSurfVecs(zxp, exp, ssurfp, sfirst, slast);
+            mesh->calcEdgeLen(pxp, elen, sfirst, slast);
+            mesh->calcCharLen(sareap, zdl, sfirst, slast);
+        }
+        t0 = timer->lap(Timer::PH_PREDGEOM, t0);
 
         // 2. compute point masses
         calcRho(zm, zvolp, zrp, zfirst, zlast);
         calcCrnrMass(zrp, zareap, smf, cmaswt, sfirst, slast);
+        t0 = timer->lap(Timer::PH_MASS, t0);
 
         // 3. compute material state (half-advanced)
         pgas->calcStateAtHalf(zr, zvolp, zvol0, ze, zwrate, zm, dt,
                 zp, zss, zfirst, zlast);
+        t0 = timer->lap(Timer::PH_STATE, t0);
 
         // 4. compute forces
-        pgas->calcForce(zp, ssurfp, sfp, sfirst, slast);
-        tts->calcForce(zareap, zrp, zss, sareap, smf, ssurfp, sft,
-                sfirst, slast);
-        qcs->calcForce(sfq, sfirst, slast);
-        sumCrnrForce(sfp, sfq, sft, cftot, sfirst, slast);
+        if (fusedforce) {
+            qcs->calcForce(sfq, sfirst, slast);
+            t0 = timer->start();
+            if (mesh->leanmem)
+                calcCrnrForceLean(zp, zareap, zrp, zss, smf, pxp, exp, zxp,
+                        sfq, cftot, sfirst, slast);
+            else
+                calcCrnrForceFused(zp, zareap, zrp, zss, sareap, smf,
+                        ssurfp, sfq, cftot, sfirst, slast);
+        } else {
+            pgas->calcForce(zp, ssurfp, sfp, sfirst, slast);
+            t0 = timer->lap(Timer::PH_PGASF, t0);
+            tts->calcForce(zareap, zrp, zss, sareap, smf, ssurfp, sft,
+                    sfirst, slast);
+            t0 = timer->lap(Timer::PH_TTSF, t0);
+            qcs->calcForce(sfq, sfirst, slast);
+            t0 = timer->start();
+            sumCrnrForce(sfp, sfq, sft, cftot, sfirst, slast);
+        }
+        timer->lap(Timer::PH_CRNRF, t0);
     }  // for sch
     mesh->checkBadSides();
 
@@ -251,6 +510,7 @@ void Hydro::doCycle(
     for (int pch = 0; pch < numpch; ++pch) {
         int pfirst = mesh->pchpfirst[pch];
         int plast = mesh->pchplast[pch];
+        double t0 = timer->start();
 
         // 4a. apply boundary conditions
         for (int i = 0; i < bcs.size(); ++i) {
@@ -265,6 +525,7 @@ void Hydro::doCycle(
         // ===== Corrector step =====
         // 6. advance mesh to end of time step
         advPosFull(px0, pu0, pap, dt, px, pu, pfirst, plast);
+        timer->lap(Timer::PH_CORRPT, t0);
     }  // for pch
 
     resetDtHydro();
@@ -275,16 +536,28 @@ void Hydro::doCycle(
         int slast = mesh->schslast[sch];
         int zfirst = mesh->schzfirst[sch];
         int zlast = mesh->schzlast[sch];
+        double t0 = timer->start();
 
         // 6a. compute new mesh geometry
-        mesh->calcCtrs(px, ex, zx, sfirst, slast);
-        mesh->calcVols(px, zx, sarea, svol, zarea, zvol,
-                sfirst, slast);
+        if (mesh->leanmem) {
+            mesh->calcZoneGeom(px, zx, zarea, zvol, sfirst, slast);
+        } else {
+            mesh->calcCtrs(px, ex, zx, sfirst, slast);
+            t0 = timer->lap(Timer::PH_CORRCTRS, t0);
+            mesh->calcVols(px, zx, sarea, svol, zarea, zvol,
+                    sfirst, slast);
+        }
+        t0 = timer->lap(Timer::PH_CORRVOLS, t0);
 
         // 7. compute work
         fill(&zw[zfirst], &zw[zlast], 0.);
-        calcWork(sfp, sfq, pu0, pu, pxp, dt, zw, zetot,
-                sfirst, slast);
+        if (fusedforce)
+            calcWork(sfq, const_double2ptr(), pu0, pu, pxp, dt, zw, zetot,
+                    sfirst, slast);
+        else
+            calcWork(sfp, sfq, pu0, pu, pxp, dt, zw, zetot,
+                    sfirst, slast);
+        timer->lap(Timer::PH_WORK, t0);
     }  // for sch
     mesh->checkBadSides();
 
@@ -292,6 +565,7 @@ void Hydro::doCycle(
     for (int zch = 0; zch < mesh->numzch; ++zch) {
         int zfirst = mesh->zchzfirst[zch];
         int zlast = mesh->zchzlast[zch];
+        double t0 = timer->start();
 
         // 7a. compute work rate
         calcWorkRate(zvol0, zvol, zw, zp, dt, zwrate, zfirst, zlast);
@@ -299,23 +573,40 @@ void Hydro::doCycle(
         // 8. update state variables
         calcEnergy(zetot, zm, ze, zfirst, zlast);
         calcRho(zm, zvol, zr, zfirst, zlast);
+        t0 = timer->lap(Timer::PH_ZONEUPD, t0);
 
         // 9.  compute timestep for next cycle
         calcDtHydro(zdl, zvol, zvol0, dt, zfirst, zlast);
+        timer->lap(Timer::PH_DTHYDRO, t0);
     }  // for zch
 
 }
 
 
 void Hydro::advPosHalf(
-        const double2* px0,
-        const double2* pu0,
+        const_double2ptr px0,
+        const_double2ptr pu0,
         const double dt,
-        double2* pxp,
+        double2ptr pxp,
         const int pfirst,
         const int plast) {
 
-    double dth = 0.5 * dt;
+    advPosHalf<FieldsOne>(px0, pu0, dt, pxp, pfirst, plast);
+
+}
+
+
+template <typename FT>
+void Hydro::advPosHalf(
+        typename FT::cptr2 px0,
+        typename FT::cptr2 pu0,
+        const typename FT::real dt,
+        typename FT::ptr2 pxp,
+        const int pfirst,
+        const int plast) {
+
+    typedef typename FT::real real;
+    real dth = 0.5 * dt;
 
     #pragma ivdep
     for (int p = pfirst; p < plast; ++p) {
@@ -325,12 +616,28 @@ void Hydro::advPosHalf(
 
 
 void Hydro::advPosFull(
-        const double2* px0,
-        const double2* pu0,
-        const double2* pa,
+        const_double2ptr px0,
+        const_double2ptr pu0,
+        const_double2ptr pa,
         const double dt,
-        double2* px,
-        double2* pu,
+        double2ptr px,
+        double2ptr pu,
+        const int pfirst,
+        const int plast) {
+
+    advPosFull<FieldsOne>(px0, pu0, pa, dt, px, pu, pfirst, plast);
+
+}
+
+
+template <typename FT>
+void Hydro::advPosFull(
+        typename FT::cptr2 px0,
+        typename FT::cptr2 pu0,
+        typename FT::cptr2 pa,
+        const typename FT::real dt,
+        typename FT::ptr2 px,
+        typename FT::ptr2 pu,
         const int pfirst,
         const int plast) {
 
@@ -351,40 +658,250 @@ void Hydro::calcCrnrMass(
         const int sfirst,
         const int slast) {
 
+    const CalcCrnrMassOp op = { zr, zarea, smf, cmaswt, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::calcCrnrMass(
+        const SM sm,
+        typename FT::cptr zr,
+        typename FT::cptr zarea,
+        const double* smf,
+        typename FT::ptr cmaswt,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int s3 = mesh->mapss3[s];
-        int z = mesh->mapsz[s];
+        int s3 = sm.prev(s);
+        int z = sm.zone(s);
 
-        double m = zr[z] * zarea[z] * 0.5 * (smf[s] + smf[s3]);
+        real m = zr[z] * zarea[z] * 0.5 * (smf[s] + smf[s3]);
         cmaswt[s] = m;
     }
 }
 
 
 void Hydro::sumCrnrForce(
-        const double2* sf,
-        const double2* sf2,
-        const double2* sf3,
-        double2* cftot,
+        const_double2ptr sf,
+        const_double2ptr sf2,
+        const_double2ptr sf3,
+        double2ptr cftot,
         const int sfirst,
         const int slast) {
 
+    const SumCrnrForceOp op = { sf, sf2, sf3, cftot, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::sumCrnrForce(
+        const SM sm,
+        typename FT::cptr2 sf,
+        typename FT::cptr2 sf2,
+        typename FT::cptr2 sf3,
+        typename FT::ptr2 cftot,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real2 real2;
+
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int s3 = mesh->mapss3[s];
+        int s3 = sm.prev(s);
 
-        double2 f = (sf[s] + sf2[s] + sf3[s]) -
-                    (sf[s3] + sf2[s3] + sf3[s3]);
+        real2 f = (sf[s] + sf2[s] + sf3[s]) -
+                  (sf[s3] + sf2[s3] + sf3[s3]);
         cftot[s] = f;
     }
 }
 
 
+void Hydro::calcCrnrForceFused(
+        const double* zp,
+        const double* zareap,
+        const double* zrp,
+        const double* zss,
+        const double* sareap,
+        const double* smf,
+        const_double2ptr ssurfp,
+        double2ptr sfq,
+        double2ptr cftot,
+        const int sfirst,
+        const int slast) {
+
+    const double alfa = tts->alfa;
+    const double ssmin = tts->ssmin;
+    const CalcCrnrForceFusedOp op = { alfa, ssmin, zp, zareap, zrp, zss,
+            sareap, smf, ssurfp, sfq, cftot, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::calcCrnrForceFused(
+        const SM sm,
+        const typename FT::real alfa,
+        const typename FT::real ssmin,
+        typename FT::cptr zp,
+        typename FT::cptr zareap,
+        typename FT::cptr zrp,
+        typename FT::cptr zss,
+        typename FT::cptr sareap,
+        const double* smf,
+        typename FT::cptr2 ssurfp,
+        typename FT::ptr2 sfq,
+        typename FT::ptr2 cftot,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    // side forces as in PolyGas::calcForce and TTS::calcForce,
+    // summed in the same order as in sumCrnrForce
+
+    // the sides of a zone are contiguous, and each side's
+    // previous side (mapss3) is the one before it, except for
+    // the first side of the zone
+    for (int sz = sfirst; sz < slast; sz += sm.size(sm.zone(sz))) {
+        const int z = sm.zone(sz);
+        const int szlast = sz + sm.size(z);
+
+        const real mzp = -zp[z];
+        real sstmp = max(zss[z], ssmin);
+        sstmp = alfa * sstmp * sstmp;
+
+        // total side force, stored in cftot for now
+        for (int s = sz; s < szlast; ++s) {
+            real2 sfpx = mzp * ssurfp[s];
+            real svfacinv = zareap[z] / sareap[s];
+            real srho = zrp[z] * smf[s] * svfacinv;
+            real sdp = sstmp * (srho - zrp[z]);
+            real2 sftx = -sdp * ssurfp[s];
+
+            real2 sfpq = sfpx + sfq[s];
+            sfq[s] = sfpq;
+            cftot[s] = sfpq + sftx;
+        }
+
+        // corner force:  side force minus previous side's
+        const real2 sflast = cftot[sm.prev(sz)];
+        for (int s = szlast - 1; s > sz; --s)
+            cftot[s] = cftot[s] - cftot[s - 1];
+        cftot[sz] = cftot[sz] - sflast;
+    }  // for sz
+
+}
+
+
+void Hydro::calcCrnrForceLean(
+        const double* zp,
+        const double* zareap,
+        const double* zrp,
+        const double* zss,
+        const double* smf,
+        const_double2ptr pxp,
+        const_double2ptr exp,
+        const_double2ptr zxp,
+        double2ptr sfq,
+        double2ptr cftot,
+        const int sfirst,
+        const int slast) {
+
+    const double alfa = tts->alfa;
+    const double ssmin = tts->ssmin;
+    const CalcCrnrForceLeanOp op = { alfa, ssmin, zp, zareap, zrp, zss, smf,
+            pxp, exp, zxp, sfq, cftot, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::calcCrnrForceLean(
+        const SM sm,
+        const typename FT::real alfa,
+        const typename FT::real ssmin,
+        typename FT::cptr zp,
+        typename FT::cptr zareap,
+        typename FT::cptr zrp,
+        typename FT::cptr zss,
+        const double* smf,
+        typename FT::cptr2 pxp,
+        typename FT::cptr2 exp,
+        typename FT::cptr2 zxp,
+        typename FT::ptr2 sfq,
+        typename FT::ptr2 cftot,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    // as calcCrnrForceFused, with side area and surface vector
+    // computed as in Mesh::calcGeomFused instead of read
+    for (int sz = sfirst; sz < slast; sz += sm.size(sm.zone(sz))) {
+        const int z = sm.zone(sz);
+        const int szlast = sz + sm.size(z);
+
+        const real mzp = -zp[z];
+        real sstmp = max(zss[z], ssmin);
+        sstmp = alfa * sstmp * sstmp;
+        const real2 zxz = zxp[z];
+
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            int e = sm.edge(s);
+            real sa = 0.5 * cross(pxp[p2] - pxp[p1], zxz - pxp[p1]);
+            real2 ssurf = rotateCCW(exp[e] - zxz);
+
+            real2 sfpx = mzp * ssurf;
+            real svfacinv = zareap[z] / sa;
+            real srho = zrp[z] * smf[s] * svfacinv;
+            real sdp = sstmp * (srho - zrp[z]);
+            real2 sftx = -sdp * ssurf;
+
+            real2 sfpq = sfpx + sfq[s];
+            sfq[s] = sfpq;
+            cftot[s] = sfpq + sftx;
+        }
+
+        const real2 sflast = cftot[sm.prev(sz)];
+        for (int s = szlast - 1; s > sz; --s)
+            cftot[s] = cftot[s] - cftot[s - 1];
+        cftot[sz] = cftot[sz] - sflast;
+    }  // for sz
+
+}
+
+
 void Hydro::calcAccel(
-        const double2* pf,
+        const_double2ptr pf,
         const double* pmass,
-        double2* pa,
+        double2ptr pa,
+        const int pfirst,
+        const int plast) {
+
+    calcAccel<FieldsOne>(pf, pmass, pa, pfirst, plast);
+
+}
+
+
+template <typename FT>
+void Hydro::calcAccel(
+        typename FT::cptr2 pf,
+        typename FT::cptr pmass,
+        typename FT::ptr2 pa,
         const int pfirst,
         const int plast) {
 
@@ -405,6 +922,19 @@ void Hydro::calcRho(
         const int zfirst,
         const int zlast) {
 
+    calcRho<FieldsOne>(zm, zvol, zr, zfirst, zlast);
+
+}
+
+
+template <typename FT>
+void Hydro::calcRho(
+        typename FT::cptr zm,
+        typename FT::cptr zvol,
+        typename FT::ptr zr,
+        const int zfirst,
+        const int zlast) {
+
     #pragma ivdep
     for (int z = zfirst; z < zlast; ++z) {
         zr[z] = zm[z] / zvol[z];
@@ -414,33 +944,57 @@ void Hydro::calcRho(
 
 
 void Hydro::calcWork(
-        const double2* sf,
-        const double2* sf2,
-        const double2* pu0,
-        const double2* pu,
-        const double2* px,
+        const_double2ptr sf,
+        const_double2ptr sf2,
+        const_double2ptr pu0,
+        const_double2ptr pu,
+        const_double2ptr px,
         const double dt,
         double* zw,
         double* zetot,
         const int sfirst,
         const int slast) {
 
+    const CalcWorkOp op = { sf, sf2, pu0, pu, px, dt, zw, zetot, sfirst,
+            slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::calcWork(
+        const SM sm,
+        typename FT::cptr2 sf,
+        typename FT::cptr2 sf2,
+        typename FT::cptr2 pu0,
+        typename FT::cptr2 pu,
+        typename FT::cptr2 px,
+        const typename FT::real dt,
+        typename FT::ptr zw,
+        typename FT::ptr zetot,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
     // Compute the work done by finding, for each element/node pair,
     //   dwork= force * vavg
     // where force is the force of the element on the node
     // and vavg is the average velocity of the node over the time period
 
-    const double dth = 0.5 * dt;
+    const real dth = 0.5 * dt;
 
     for (int s = sfirst; s < slast; ++s) {
-        int p1 = mesh->mapsp1[s];
-        int p2 = mesh->mapsp2[s];
-        int z = mesh->mapsz[s];
+        int p1 = sm.p1(s);
+        int p2 = sm.p2(s);
+        int z = sm.zone(s);
 
-        double2 sftot = sf[s] + sf2[s];
-        double sd1 = dot( sftot, (pu0[p1] + pu[p1]));
-        double sd2 = dot(-sftot, (pu0[p2] + pu[p2]));
-        double dwork = -dth * (sd1 * px[p1].x + sd2 * px[p2].x);
+        real2 sftot = (sf2 ? sf[s] + sf2[s] : sf[s]);
+        real sd1 = dot( sftot, (pu0[p1] + pu[p1]));
+        real sd2 = dot(-sftot, (pu0[p2] + pu[p2]));
+        real dwork = -dth * (sd1 * px[p1].x + sd2 * px[p2].x);
 
         zetot[z] += dwork;
         zw[z] += dwork;
@@ -459,10 +1013,27 @@ void Hydro::calcWorkRate(
         double* zwrate,
         const int zfirst,
         const int zlast) {
-    double dtinv = 1. / dt;
+
+    calcWorkRate<FieldsOne>(zvol0, zvol, zw, zp, dt, zwrate, zfirst, zlast);
+
+}
+
+
+template <typename FT>
+void Hydro::calcWorkRate(
+        typename FT::cptr zvol0,
+        typename FT::cptr zvol,
+        typename FT::cptr zw,
+        typename FT::cptr zp,
+        const typename FT::real dt,
+        typename FT::ptr zwrate,
+        const int zfirst,
+        const int zlast) {
+    typedef typename FT::real real;
+    real dtinv = 1. / dt;
     #pragma ivdep
     for (int z = zfirst; z < zlast; ++z) {
-        double dvol = zvol[z] - zvol0[z];
+        real dvol = zvol[z] - zvol0[z];
         zwrate[z] = (zw[z] + zp[z] * dvol) * dtinv;
     }
 
@@ -476,6 +1047,19 @@ void Hydro::calcEnergy(
         const int zfirst,
         const int zlast) {
 
+    calcEnergy<FieldsOne>(zetot, zm, ze, zfirst, zlast);
+
+}
+
+
+template <typename FT>
+void Hydro::calcEnergy(
+        typename FT::cptr zetot,
+        typename FT::cptr zm,
+        typename FT::ptr ze,
+        const int zfirst,
+        const int zlast) {
+
     const double fuzz = 1.e-99;
     #pragma ivdep
     for (int z = zfirst; z < zlast; ++z) {
@@ -491,8 +1075,8 @@ void Hydro::sumEnergy(
         const double* zvol,
         const double* zm,
         const double* smf,
-        const double2* px,
-        const double2* pu,
+        const_double2ptr px,
+        const_double2ptr pu,
         double& ei,
         double& ek,
         const int zfirst,
@@ -500,8 +1084,34 @@ void Hydro::sumEnergy(
         const int sfirst,
         const int slast) {
 
+    const SumEnergyOp op = { zetot, zarea, zvol, zm, smf, px, pu, ei, ek,
+            zfirst, zlast, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Hydro::sumEnergy(
+        const SM sm,
+        typename FT::cptr zetot,
+        typename FT::cptr zarea,
+        typename FT::cptr zvol,
+        typename FT::cptr zm,
+        const double* smf,
+        typename FT::cptr2 px,
+        typename FT::cptr2 pu,
+        typename FT::real& ei,
+        typename FT::real& ek,
+        const int zfirst,
+        const int zlast,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+
     // compute internal energy
-    double sumi = 0.; 
+    real sumi = 0.; 
     for (int z = zfirst; z < zlast; ++z) {
         sumi += zetot[z];
     }
@@ -513,14 +1123,14 @@ void Hydro::sumEnergy(
     // zone ke = zone mass * (volume-weighted average of .5 * u ^ 2)
     //         = zm sum(c in z) [cvol / zvol * .5 * u ^ 2]
     //         = sum(c in z) [zm * cvol / zvol * .5 * u ^ 2]
-    double sumk = 0.; 
+    real sumk = 0.; 
     for (int s = sfirst; s < slast; ++s) {
-        int s3 = mesh->mapss3[s];
-        int p1 = mesh->mapsp1[s];
-        int z = mesh->mapsz[s];
+        int s3 = sm.prev(s);
+        int p1 = sm.p1(s);
+        int z = sm.zone(s);
 
-        double cvol = zarea[z] * px[p1].x * 0.5 * (smf[s] + smf[s3]);
-        double cke = zm[z] * cvol / zvol[z] * 0.5 * length2(pu[p1]);
+        real cvol = zarea[z] * px[p1].x * 0.5 * (smf[s] + smf[s3]);
+        real cke = zm[z] * cvol / zvol[z] * 0.5 * length2(pu[p1]);
         sumk += cke;
     }
     // multiply by 2\pi for cylindrical geometry
@@ -536,24 +1146,48 @@ void Hydro::calcDtCourant(
         const int zfirst,
         const int zlast) {
 
-    const double fuzz = 1.e-99;
-    double dtnew = 1.e99;
-    int zmin = -1;
-    for (int z = zfirst; z < zlast; ++z) {
-        double cdu = max(zdu[z], max(zss[z], fuzz));
-        double zdthyd = zdl[z] * cfl / cdu;
-        zmin = (zdthyd < dtnew ? z : zmin);
-        dtnew = (zdthyd < dtnew ? zdthyd : dtnew);
-    }
+    double dtnew;
+    int zmin;
+    calcDtCourant<FieldsOne>(cfl, zdu, zss, zdl, dtnew, zmin,
+            zfirst, zlast);
 
     if (dtnew < dtrec) {
         dtrec = dtnew;
+        // report the zone as generated, if the mesh was reordered
+        if (!mesh->zoneorig.empty()) zmin = mesh->zoneorig[zmin];
         snprintf(msgdtrec, 80, "Hydro Courant limit for z = %d", zmin);
     }
 
 }
 
 
+template <typename FT>
+void Hydro::calcDtCourant(
+        const typename FT::real cfl,
+        typename FT::cptr zdu,
+        typename FT::cptr zss,
+        typename FT::cptr zdl,
+        typename FT::real& dtnew,
+        typename FT::index& zmin,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::index index;
+
+    const double fuzz = 1.e-99;
+    dtnew = 1.e99;
+    zmin = -1;
+    for (int z = zfirst; z < zlast; ++z) {
+        real cdu = max(zdu[z], max(zss[z], fuzz));
+        real zdthyd = zdl[z] * cfl / cdu;
+        zmin = select(zdthyd < dtnew, index(z), zmin);
+        dtnew = select(zdthyd < dtnew, zdthyd, dtnew);
+    }
+
+}
+
+
 void Hydro::calcDtVolume(
         const double* zvol,
         const double* zvol0,
@@ -563,22 +1197,47 @@ void Hydro::calcDtVolume(
         const int zfirst,
         const int zlast) {
 
-    double dvovmax = 1.e-99;
-    int zmax = -1;
-    for (int z = zfirst; z < zlast; ++z) {
-        double zdvov = abs((zvol[z] - zvol0[z]) / zvol0[z]);
-        zmax = (zdvov > dvovmax ? z : zmax);
-        dvovmax = (zdvov > dvovmax ? zdvov : dvovmax);
-    }
-    double dtnew = dtlast * cflv / dvovmax;
+    double dtnew;
+    int zmax;
+    calcDtVolume<FieldsOne>(cflv, zvol, zvol0, dtlast, dtnew, zmax,
+            zfirst, zlast);
+
     if (dtnew < dtrec) {
         dtrec = dtnew;
+        // report the zone as generated, if the mesh was reordered
+        if (!mesh->zoneorig.empty()) zmax = mesh->zoneorig[zmax];
         snprintf(msgdtrec, 80, "Hydro dV/V limit for z = %d", zmax);
     }
 
 }
 
 
+template <typename FT>
+void Hydro::calcDtVolume(
+        const typename FT::real cflv,
+        typename FT::cptr zvol,
+        typename FT::cptr zvol0,
+        const typename FT::real dtlast,
+        typename FT::real& dtnew,
+        typename FT::index& zmax,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::index index;
+
+    real dvovmax = 1.e-99;
+    zmax = -1;
+    for (int z = zfirst; z < zlast; ++z) {
+        real zdvov = abs((zvol[z] - zvol0[z]) / zvol0[z]);
+        zmax = select(zdvov > dvovmax, index(z), zmax);
+        dvovmax = select(zdvov > dvovmax, zdvov, dvovmax);
+    }
+    dtnew = dtlast * cflv / dvovmax;
+
+}
+
+
 void Hydro::calcDtHydro(
         const double* zdl,
         const double* zvol,
@@ -627,12 +1286,10 @@ void Hydro::resetDtHydro() {
 }
 
 
-void Hydro::writeEnergyCheck() {
+void Hydro::calcEnergyCheck(double& ei, double& ek) {
 
-    using Parallel::mype;
-    
-    double ei = 0.;
-    double ek = 0.;
+    ei = 0.;
+    ek = 0.;
     #pragma omp parallel for schedule(static)
     for (int sch = 0; sch < mesh->numsch; ++sch) {
         int sfirst = mesh->schsfirst[sch];
@@ -655,6 +1312,16 @@ void Hydro::writeEnergyCheck() {
     Parallel::globalSum(ei);
     Parallel::globalSum(ek);
 
+}
+
+
+void Hydro::writeEnergyCheck() {
+
+    using Parallel::mype;
+
+    double ei, ek;
+    calcEnergyCheck(ei, ek);
+
     if (mype == 0) {
         cout << scientific << setprecision(6);
         cout << "Energy check:  "
@@ -664,3 +1331,50 @@ void Hydro::writeEnergyCheck() {
     }
 
  }
+
+
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES(FT) \
+    template void Hydro::advPosHalf<FT>(FT::cptr2, FT::cptr2, \
+            const FT::real, FT::ptr2, const int, const int); \
+    template void Hydro::advPosFull<FT>(FT::cptr2, FT::cptr2, FT::cptr2, \
+            const FT::real, FT::ptr2, FT::ptr2, const int, const int); \
+    template void Hydro::calcAccel<FT>(FT::cptr2, FT::cptr, FT::ptr2, \
+            const int, const int); \
+    template void Hydro::calcRho<FT>(FT::cptr, FT::cptr, FT::ptr, \
+            const int, const int); \
+    template void Hydro::calcWorkRate<FT>(FT::cptr, FT::cptr, FT::cptr, \
+            FT::cptr, const FT::real, FT::ptr, const int, const int); \
+    template void Hydro::calcEnergy<FT>(FT::cptr, FT::cptr, FT::ptr, \
+            const int, const int); \
+    template void Hydro::calcDtCourant<FT>(const FT::real, FT::cptr, \
+            FT::cptr, FT::cptr, FT::real&, FT::index&, const int, \
+            const int); \
+    template void Hydro::calcDtVolume<FT>(const FT::real, FT::cptr, \
+            FT::cptr, const FT::real, FT::real&, FT::index&, const int, \
+            const int);
+FOR_EACH_LANES(INSTANTIATE_LANES)
+#undef INSTANTIATE_LANES
+
+#define INSTANTIATE_LANES_SM(FT, SM) \
+    template void Hydro::calcCrnrMass<FT, SM>(const SM, FT::cptr, \
+            FT::cptr, const double*, FT::ptr, const int, const int); \
+    template void Hydro::sumCrnrForce<FT, SM>(const SM, FT::cptr2, \
+            FT::cptr2, FT::cptr2, FT::ptr2, const int, const int); \
+    template void Hydro::calcCrnrForceFused<FT, SM>(const SM, \
+            const FT::real, const FT::real, FT::cptr, FT::cptr, FT::cptr, \
+            FT::cptr, FT::cptr, const double*, FT::cptr2, FT::ptr2, \
+            FT::ptr2, const int, const int); \
+    template void Hydro::calcCrnrForceLean<FT, SM>(const SM, \
+            const FT::real, const FT::real, FT::cptr, FT::cptr, FT::cptr, \
+            FT::cptr, const double*, FT::cptr2, FT::cptr2, FT::cptr2, \
+            FT::ptr2, FT::ptr2, const int, const int); \
+    template void Hydro::calcWork<FT, SM>(const SM, FT::cptr2, FT::cptr2, \
+            FT::cptr2, FT::cptr2, FT::cptr2, const FT::real, FT::ptr, \
+            FT::ptr, const int, const int); \
+    template void Hydro::sumEnergy<FT, SM>(const SM, FT::cptr, FT::cptr, \
+            FT::cptr, FT::cptr, const double*, FT::cptr2, FT::cptr2, \
+            FT::real&, FT::real&, const int, const int, const int, \
+            const int);
+FOR_EACH_LANES_SM(INSTANTIATE_LANES_SM)
+#undef INSTANTIATE_LANES_SM
@@ -16,7 +16,8 @@
 #include <string>
 #include <vector>
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
 
 // forward declarations
 class InputFile;
@@ -25,6 +26,8 @@ class PolyGas;
 class TTS;
 class QCS;
 class HydroBC;
+class ChkptWriter;
+class ChkptReader;
 
 
 class Hydro {
@@ -48,14 +51,15 @@ public:
     double uinitradial;         // initial velocity in radial direction
     std::vector<double> bcx;    // x values of x-plane fixed boundaries
     std::vector<double> bcy;    // y values of y-plane fixed boundaries
+    bool fusedforce;            // flag:  use calcCrnrForceFused?
 
     double dtrec;               // maximum timestep for hydro
     char msgdtrec[80];          // message:  reason for dtrec
 
-    double2* pu;       // point velocity
-    double2* pu0;      // point velocity, start of cycle
-    double2* pap;      // point acceleration
-    double2* pf;       // point force
+    double2ptr pu;       // point velocity
+    double2ptr pu0;      // point velocity, start of cycle
+    double2ptr pap;      // point acceleration
+    double2ptr pf;       // point force
     double* pmaswt;    // point mass, weighted by 1/r
     double* cmaswt;    // corner contribution to pmaswt
 
@@ -71,16 +75,31 @@ public:
     double* zss;       // zone sound speed
     double* zdu;       // zone velocity difference
 
-    double2* sfp;      // side force from pressure
-    double2* sfq;      // side force from artificial visc.
-    double2* sft;      // side force from tts
-    double2* cftot;    // corner force, total from all sources
+    double2ptr sfp;      // side force from pressure
+                       // (NULL if fusedforce)
+    double2ptr sfq;      // side force from artificial visc.
+                       // (pressure + a.v. if fusedforce)
+    double2ptr sft;      // side force from tts
+                       // (NULL if fusedforce)
+    double2ptr cftot;    // corner force, total from all sources
 
-    Hydro(const InputFile* inp, Mesh* m);
+    Hydro(const InputFile* inp, Mesh* m, ChkptReader* cr);
     ~Hydro();
 
     void init();
 
+    // allocate state arrays
+    void initArrays();
+
+    // place state arrays on NUMA nodes (see Mesh::placeArrays)
+    void placeArrays();
+
+    // restore hydro state from checkpoint
+    void initFromChkpt(ChkptReader& cr);
+
+    // add hydro state to checkpoint
+    void writeChkpt(ChkptWriter& cw);
+
     void initRadialVel(
             const double vel,
             const int pfirst,
@@ -88,21 +107,45 @@ public:
 
     void doCycle(const double dt);
 
+    // each kernel below has a plain version for this problem,
+    // which calls a static version templated on field types (see
+    // FieldTypes.hh), and for side loops on a side map (see
+    // SideMap.hh), with FieldsOne; HydroLanes calls the templated
+    // versions for its lanes
+
     void advPosHalf(
-            const double2* px0,
-            const double2* pu0,
+            const_double2ptr px0,
+            const_double2ptr pu0,
             const double dt,
-            double2* pxp,
+            double2ptr pxp,
+            const int pfirst,
+            const int plast);
+    template <typename FT>
+    static void advPosHalf(
+            typename FT::cptr2 px0,
+            typename FT::cptr2 pu0,
+            const typename FT::real dt,
+            typename FT::ptr2 pxp,
             const int pfirst,
             const int plast);
 
     void advPosFull(
-            const double2* px0,
-            const double2* pu0,
-            const double2* pa,
+            const_double2ptr px0,
+            const_double2ptr pu0,
+            const_double2ptr pa,
             const double dt,
-            double2* px,
-            double2* pu,
+            double2ptr px,
+            double2ptr pu,
+            const int pfirst,
+            const int plast);
+    template <typename FT>
+    static void advPosFull(
+            typename FT::cptr2 px0,
+            typename FT::cptr2 pu0,
+            typename FT::cptr2 pa,
+            const typename FT::real dt,
+            typename FT::ptr2 px,
+            typename FT::ptr2 pu,
             const int pfirst,
             const int plast);
 
@@ -113,19 +156,110 @@ public:
             double* cmaswt,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    static void calcCrnrMass(
+            const SM sm,
+            typename FT::cptr zr,
+            typename FT::cptr zarea,
+            const double* smf,
+            typename FT::ptr cmaswt,
+            const int sfirst,
+            const int slast);
 
     void sumCrnrForce(
-            const double2* sf,
-            const double2* sf2,
-            const double2* sf3,
-            double2* cftot,
+            const_double2ptr sf,
+            const_double2ptr sf2,
+            const_double2ptr sf3,
+            double2ptr cftot,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void sumCrnrForce(
+            const SM sm,
+            typename FT::cptr2 sf,
+            typename FT::cptr2 sf2,
+            typename FT::cptr2 sf3,
+            typename FT::ptr2 cftot,
+            const int sfirst,
+            const int slast);
+
+    // compute pressure and TTS side forces, add them to the
+    // artificial viscosity force in sfq, and compute corner
+    // forces; the sfq array then holds pressure + a.v. force
+    void calcCrnrForceFused(
+            const double* zp,
+            const double* zareap,
+            const double* zrp,
+            const double* zss,
+            const double* sareap,
+            const double* smf,
+            const_double2ptr ssurfp,
+            double2ptr sfq,
+            double2ptr cftot,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void calcCrnrForceFused(
+            const SM sm,
+            const typename FT::real alfa,
+            const typename FT::real ssmin,
+            typename FT::cptr zp,
+            typename FT::cptr zareap,
+            typename FT::cptr zrp,
+            typename FT::cptr zss,
+            typename FT::cptr sareap,
+            const double* smf,
+            typename FT::cptr2 ssurfp,
+            typename FT::ptr2 sfq,
+            typename FT::ptr2 cftot,
+            const int sfirst,
+            const int slast);
+
+    // as calcCrnrForceFused, for lean memory mode (see
+    // Mesh::leanmem):  side areas and surface vectors are
+    // computed from pxp, exp and zxp
+    void calcCrnrForceLean(
+            const double* zp,
+            const double* zareap,
+            const double* zrp,
+            const double* zss,
+            const double* smf,
+            const_double2ptr pxp,
+            const_double2ptr exp,
+            const_double2ptr zxp,
+            double2ptr sfq,
+            double2ptr cftot,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void calcCrnrForceLean(
+            const SM sm,
+            const typename FT::real alfa,
+            const typename FT::real ssmin,
+            typename FT::cptr zp,
+            typename FT::cptr zareap,
+            typename FT::cptr zrp,
+            typename FT::cptr zss,
+            const double* smf,
+            typename FT::cptr2 pxp,
+            typename FT::cptr2 exp,
+            typename FT::cptr2 zxp,
+            typename FT::ptr2 sfq,
+            typename FT::ptr2 cftot,
             const int sfirst,
             const int slast);
 
     void calcAccel(
-            const double2* pf,
+            const_double2ptr pf,
             const double* pmass,
-            double2* pa,
+            double2ptr pa,
+            const int pfirst,
+            const int plast);
+    template <typename FT>
+    static void calcAccel(
+            typename FT::cptr2 pf,
+            typename FT::cptr pmass,
+            typename FT::ptr2 pa,
             const int pfirst,
             const int plast);
 
@@ -135,18 +269,39 @@ public:
             double* zr,
             const int zfirst,
             const int zlast);
+    template <typename FT>
+    static void calcRho(
+            typename FT::cptr zm,
+            typename FT::cptr zvol,
+            typename FT::ptr zr,
+            const int zfirst,
+            const int zlast);
 
+    // sf2 may be NULL, if sf holds the total force
     void calcWork(
-            const double2* sf,
-            const double2* sf2,
-            const double2* pu0,
-            const double2* pu,
-            const double2* px0,
+            const_double2ptr sf,
+            const_double2ptr sf2,
+            const_double2ptr pu0,
+            const_double2ptr pu,
+            const_double2ptr px0,
             const double dt,
             double* zw,
             double* zetot,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    static void calcWork(
+            const SM sm,
+            typename FT::cptr2 sf,
+            typename FT::cptr2 sf2,
+            typename FT::cptr2 pu0,
+            typename FT::cptr2 pu,
+            typename FT::cptr2 px0,
+            const typename FT::real dt,
+            typename FT::ptr zw,
+            typename FT::ptr zetot,
+            const int sfirst,
+            const int slast);
 
     void calcWorkRate(
             const double* zvol0,
@@ -157,6 +312,16 @@ public:
             double* zwrate,
             const int zfirst,
             const int zlast);
+    template <typename FT>
+    static void calcWorkRate(
+            typename FT::cptr zvol0,
+            typename FT::cptr zvol,
+            typename FT::cptr zw,
+            typename FT::cptr zp,
+            const typename FT::real dt,
+            typename FT::ptr zwrate,
+            const int zfirst,
+            const int zlast);
 
     void calcEnergy(
             const double* zetot,
@@ -164,6 +329,13 @@ public:
             double* ze,
             const int zfirst,
             const int zlast);
+    template <typename FT>
+    static void calcEnergy(
+            typename FT::cptr zetot,
+            typename FT::cptr zm,
+            typename FT::ptr ze,
+            const int zfirst,
+            const int zlast);
 
     void sumEnergy(
             const double* zetot,
@@ -171,14 +343,30 @@ public:
             const double* zvol,
             const double* zm,
             const double* smf,
-            const double2* px,
-            const double2* pu,
+            const_double2ptr px,
+            const_double2ptr pu,
             double& ei,
             double& ek,
             const int zfirst,
             const int zlast,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    static void sumEnergy(
+            const SM sm,
+            typename FT::cptr zetot,
+            typename FT::cptr zarea,
+            typename FT::cptr zvol,
+            typename FT::cptr zm,
+            const double* smf,
+            typename FT::cptr2 px,
+            typename FT::cptr2 pu,
+            typename FT::real& ei,
+            typename FT::real& ek,
+            const int zfirst,
+            const int zlast,
+            const int sfirst,
+            const int slast);
 
     void calcDtCourant(
             const double* zdl,
@@ -186,6 +374,17 @@ public:
             char* msgdtrec,
             const int zfirst,
             const int zlast);
+    // find the smallest Courant time step, and its zone
+    template <typename FT>
+    static void calcDtCourant(
+            const typename FT::real cfl,
+            typename FT::cptr zdu,
+            typename FT::cptr zss,
+            typename FT::cptr zdl,
+            typename FT::real& dtnew,
+            typename FT::index& zmin,
+            const int zfirst,
+            const int zlast);
 
     void calcDtVolume(
             const double* zvol,
@@ -195,6 +394,17 @@ public:
             char* msgdtrec,
             const int zfirst,
             const int zlast);
+    // find the volume change time step, and the zone limiting it
+    template <typename FT>
+    static void calcDtVolume(
+            const typename FT::real cflv,
+            typename FT::cptr zvol,
+            typename FT::cptr zvol0,
+            const typename FT::real dtlast,
+            typename FT::real& dtnew,
+            typename FT::index& zmax,
+            const int zfirst,
+            const int zlast);
 
     void calcDtHydro(
             const double* zdl,
@@ -210,6 +420,9 @@ public:
 
     void resetDtHydro();
 
+    // compute total internal and kinetic energy
+    void calcEnergyCheck(double& ei, double& ek);
+
     void writeEnergyCheck();
 
 }; // class Hydro
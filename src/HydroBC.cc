@@ -24,10 +24,10 @@ HydroBC::HydroBC(
         const vector<int>& mbp)
     : mesh(msh), numb(mbp.size()), vfix(v) {
 
-    mapbp = Memory::alloc<int>(numb);
+    mapbp = Memory::alloc<int>(numb, "mapbp");
     copy(mbp.begin(), mbp.end(), mapbp);
 
-    mesh->getPlaneChunks(numb, mapbp, pchbfirst, pchblast);
+    initChunks();
 
 }
 
@@ -35,19 +35,45 @@ HydroBC::HydroBC(
 HydroBC::~HydroBC() {}
 
 
+void HydroBC::initChunks() {
+    mesh->getPlaneChunks(numb, mapbp, pchbfirst, pchblast);
+}
+
+
 void HydroBC::applyFixedBC(
-        double2* pu,
-        double2* pf,
+        double2ptr pu,
+        double2ptr pf,
         const int bfirst,
         const int blast) {
 
+    applyFixedBC<FieldsOne>(pu, pf, bfirst, blast);
+
+}
+
+
+template <typename FT>
+void HydroBC::applyFixedBC(
+        typename FT::ptr2 pu,
+        typename FT::ptr2 pf,
+        const int bfirst,
+        const int blast) const {
+
+    const typename FT::real2 v(vfix);
+
     #pragma ivdep
     for (int b = bfirst; b < blast; ++b) {
         int p = mapbp[b];
 
-        pu[p] = project(pu[p], vfix);
-        pf[p] = project(pf[p], vfix);
+        pu[p] = project(pu[p], v);
+        pf[p] = project(pf[p], v);
     }
 
 }
 
+
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES(FT) \
+    template void HydroBC::applyFixedBC<FT>(FT::ptr2, FT::ptr2, \
+            const int, const int) const;
+FOR_EACH_LANES(INSTANTIATE_LANES)
+#undef INSTANTIATE_LANES
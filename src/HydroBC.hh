@@ -15,7 +15,8 @@
 
 #include <vector>
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
 
 // forward declarations
 class Mesh;
@@ -40,11 +41,22 @@ public:
 
     ~HydroBC();
 
+    // compute boundary point chunks from mesh point chunks
+    void initChunks();
+
     void applyFixedBC(
-            double2* pu,
-            double2* pf,
+            double2ptr pu,
+            double2ptr pf,
             const int bfirst,
             const int blast);
+    // version templated on field types (see FieldTypes.hh), for
+    // HydroLanes; the plain version calls it with FieldsOne
+    template <typename FT>
+    void applyFixedBC(
+            typename FT::ptr2 pu,
+            typename FT::ptr2 pf,
+            const int bfirst,
+            const int blast) const;
 
 }; // class HydroBC
 
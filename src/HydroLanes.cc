@@ -0,0 +1,708 @@
+/*
+ * HydroLanes.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "HydroLanes.hh"
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+#include "Memory.hh"
+#include "InputFile.hh"
+#include "Mesh.hh"
+#include "SideMap.hh"
+#include "Hydro.hh"
+#include "PolyGas.hh"
+#include "TTS.hh"
+#include "QCS.hh"
+#include "HydroBC.hh"
+#include "Timer.hh"
+
+using namespace std;
+
+
+namespace {
+
+// function object for dispatchSideMap (see SideMap.hh):  runs the
+// group with the side map given
+template <int W>
+struct RunOp {
+    HydroLanes<W>* lanes;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        lanes->run(sm);
+    }
+};
+
+}  // namespace
+
+
+bool HydroLanesBase::validWidth(const int width) {
+    return (width == 2 || width == 4 || width == 8);
+}
+
+
+bool HydroLanesBase::sameMesh(
+        const InputFile& inp1,
+        const InputFile& inp2) {
+
+    // the group's Mesh and Timer are built from its first problem,
+    // so every key they read must agree, as must the boundaries;
+    // subregion is read separately for each lane
+    const char* keys[] = { "meshtype", "meshparams", "chunksize",
+            "bcx", "bcy", "meshorder", "uniformsides", "structured",
+            "fusedgeom", "fusedforce", "leanmem", "numaplace", "numapin",
+            "numareport", "memalign", "hugepages", "writexy", "writegold",
+            "phasetimers", "writetimers", "perfcounters" };
+    const int numkeys = sizeof(keys) / sizeof(keys[0]);
+    for (int k = 0; k < numkeys; ++k) {
+        if (inp1.getStringList(keys[k], vector<string>()) !=
+                inp2.getStringList(keys[k], vector<string>()))
+            return false;
+    }
+    return true;
+
+}
+
+
+HydroLanesBase* HydroLanesBase::create(
+        const int width,
+        const vector<const InputFile*>& inps,
+        const vector<string>& names) {
+
+    switch (width) {
+    case 2: return new HydroLanes<2>(inps, names);
+    case 4: return new HydroLanes<4>(inps, names);
+    case 8: return new HydroLanes<8>(inps, names);
+    }
+    cerr << "Error: unsupported ensemblewidth " << width << endl;
+    exit(1);
+
+}
+
+
+template <int W>
+HydroLanes<W>::HydroLanes(
+        const vector<const InputFile*>& inps,
+        const vector<string>& nms)
+        : nummem(inps.size()), names(nms) {
+
+    if (nummem < 1 || nummem > W) {
+        cerr << "Error: " << nummem << " problems for " << W
+             << " lanes" << endl;
+        exit(1);
+    }
+
+    // the mesh, boundaries and chunks come from the first problem;
+    // all problems must agree on them
+    timer = new Timer(inps[0]);
+    mesh = new Mesh(inps[0], timer, NULL);
+    fusedforce = inps[0]->getInt("fusedforce", 1);
+    if (mesh->leanmem && !fusedforce) {
+        cerr << "Error: leanmem requires fusedforce" << endl;
+        exit(1);
+    }
+
+    vector<double> bcx = inps[0]->getDoubleList("bcx", vector<double>());
+    vector<double> bcy = inps[0]->getDoubleList("bcy", vector<double>());
+    const double2 vfixx = double2(1., 0.);
+    const double2 vfixy = double2(0., 1.);
+    for (int i = 0; i < bcx.size(); ++i)
+        bcs.push_back(new HydroBC(mesh, vfixx, mesh->getXPlane(bcx[i])));
+    for (int i = 0; i < bcy.size(); ++i)
+        bcs.push_back(new HydroBC(mesh, vfixy, mesh->getYPlane(bcy[i])));
+
+    results.resize(nummem);
+    init(inps);
+
+}
+
+
+template <int W>
+HydroLanes<W>::~HydroLanes() {
+
+    d2W* fv[] = { px, px0, pxp, pu, pu0, pap, pf, ex, exp, zx, zxp,
+            ssurfp, sfp, sfq, sft, cftot };
+    dW* fs[] = { sarea, svol, sareap, svolp, zarea, zvol, zareap, zvolp,
+            zvol0, elen, zdl, cmaswt, pmaswt, zm, zr, zrp, ze, zetot,
+            zw, zwrate, zp, zss, zdu };
+    for (int i = 0; i < sizeof(fv) / sizeof(fv[0]); ++i)
+        Memory::free(fv[i]);
+    for (int i = 0; i < sizeof(fs) / sizeof(fs[0]); ++i)
+        Memory::free(fs[i]);
+
+    for (int i = 0; i < bcs.size(); ++i) {
+        delete bcs[i];
+    }
+    delete mesh;
+    delete timer;
+
+}
+
+
+template <int W>
+void HydroLanes<W>::init(const vector<const InputFile*>& inps) {
+
+    const int nump = mesh->nump;
+    const int nume = mesh->nume;
+    const int numz = mesh->numz;
+    const int nums = mesh->nums;
+    const bool leanmem = mesh->leanmem;
+
+    px = Memory::alloc<d2W>(nump, "px (lanes)");
+    px0 = Memory::alloc<d2W>(nump, "px0 (lanes)");
+    pxp = Memory::alloc<d2W>(nump, "pxp (lanes)");
+    pu = Memory::alloc<d2W>(nump, "pu (lanes)");
+    pu0 = Memory::alloc<d2W>(nump, "pu0 (lanes)");
+    pap = Memory::alloc<d2W>(nump, "pap (lanes)");
+    pf = Memory::alloc<d2W>(nump, "pf (lanes)");
+    pmaswt = Memory::alloc<dW>(nump, "pmaswt (lanes)");
+    exp = Memory::alloc<d2W>(nume, "exp (lanes)");
+    elen = Memory::alloc<dW>(nume, "elen (lanes)");
+    zx = Memory::alloc<d2W>(numz, "zx (lanes)");
+    zxp = Memory::alloc<d2W>(numz, "zxp (lanes)");
+    zarea = Memory::alloc<dW>(numz, "zarea (lanes)");
+    zvol = Memory::alloc<dW>(numz, "zvol (lanes)");
+    zareap = Memory::alloc<dW>(numz, "zareap (lanes)");
+    zvolp = Memory::alloc<dW>(numz, "zvolp (lanes)");
+    zvol0 = Memory::alloc<dW>(numz, "zvol0 (lanes)");
+    zdl = Memory::alloc<dW>(numz, "zdl (lanes)");
+    zm = Memory::alloc<dW>(numz, "zm (lanes)");
+    zr = Memory::alloc<dW>(numz, "zr (lanes)");
+    zrp = Memory::alloc<dW>(numz, "zrp (lanes)");
+    ze = Memory::alloc<dW>(numz, "ze (lanes)");
+    zetot = Memory::alloc<dW>(numz, "zetot (lanes)");
+    zw = Memory::alloc<dW>(numz, "zw (lanes)");
+    zwrate = Memory::alloc<dW>(numz, "zwrate (lanes)");
+    zp = Memory::alloc<dW>(numz, "zp (lanes)");
+    zss = Memory::alloc<dW>(numz, "zss (lanes)");
+    zdu = Memory::alloc<dW>(numz, "zdu (lanes)");
+    sfq = Memory::alloc<d2W>(nums, "sfq (lanes)");
+    cftot = Memory::alloc<d2W>(nums, "cftot (lanes)");
+    cmaswt = Memory::alloc<dW>(nums, "cmaswt (lanes)");
+    ex = ssurfp = sfp = sft = NULL;
+    sarea = svol = sareap = svolp = NULL;
+    if (!leanmem) {
+        ex = Memory::alloc<d2W>(nume, "ex (lanes)");
+        ssurfp = Memory::alloc<d2W>(nums, "ssurfp (lanes)");
+        sarea = Memory::alloc<dW>(nums, "sarea (lanes)");
+        svol = Memory::alloc<dW>(nums, "svol (lanes)");
+        sareap = Memory::alloc<dW>(nums, "sareap (lanes)");
+        svolp = Memory::alloc<dW>(nums, "svolp (lanes)");
+    }
+    if (!fusedforce) {
+        sfp = Memory::alloc<d2W>(nums, "sfp (lanes)");
+        sft = Memory::alloc<d2W>(nums, "sft (lanes)");
+    }
+
+    // lanes beyond the number of problems start as copies of
+    // the last problem
+    for (int w = 0; w < W; ++w) {
+        const int m = min(w, nummem - 1);
+        const InputFile* inp = inps[m];
+        lanemem[w] = (w < nummem ? w : -1);
+        lanesrc[w] = (w < nummem ? w : nummem - 1);
+
+        cfl.v[w] = inp->getDouble("cfl", 0.6);
+        cflv.v[w] = inp->getDouble("cflv", 0.1);
+        gamma.v[w] = inp->getDouble("gamma", 5. / 3.);
+        ssmin.v[w] = inp->getDouble("ssmin", 0.);
+        alfa.v[w] = inp->getDouble("alfa", 0.5);
+        qgamma.v[w] = inp->getDouble("qgamma", 5. / 3.);
+        q1.v[w] = inp->getDouble("q1", 0.);
+        q2.v[w] = inp->getDouble("q2", 2.);
+        dtmax.v[w] = inp->getDouble("dtmax", 1.e99);
+        dtinit.v[w] = inp->getDouble("dtinit", 1.e99);
+        dtfac.v[w] = inp->getDouble("dtfac", 1.2);
+        tstop.v[w] = inp->getDouble("tstop", 1.e99);
+        cstop[w] = inp->getInt("cstop", 999999);
+        time.v[w] = 0.;
+        dt.v[w] = 0.;
+        dtlast.v[w] = 0.;
+        dtrec.v[w] = 1.e99;
+
+        const double rinit = inp->getDouble("rinit", 1.);
+        const double einit = inp->getDouble("einit", 0.);
+        const double rinitsub = inp->getDouble("rinitsub", 1.);
+        const double einitsub = inp->getDouble("einitsub", 0.);
+        const double uinitradial = inp->getDouble("uinitradial", 0.);
+        const vector<double> subrgn =
+                inp->getDoubleList("subregion", vector<double>());
+
+        // initial geometry is the same in all lanes
+        for (int p = 0; p < nump; ++p) {
+            px[p].x.v[w] = mesh->px[p].x;
+            px[p].y.v[w] = mesh->px[p].y;
+        }
+        if (!leanmem) {
+            for (int e = 0; e < nume; ++e) {
+                ex[e].x.v[w] = mesh->ex[e].x;
+                ex[e].y.v[w] = mesh->ex[e].y;
+            }
+            for (int s = 0; s < nums; ++s) {
+                sarea[s].v[w] = mesh->sarea[s];
+                svol[s].v[w] = mesh->svol[s];
+            }
+        }
+
+        const double eps = 1.e-12;
+        for (int z = 0; z < numz; ++z) {
+            const double2 zxz = mesh->zx[z];
+            zx[z].x.v[w] = zxz.x;
+            zx[z].y.v[w] = zxz.y;
+            zarea[z].v[w] = mesh->zarea[z];
+            zvol[z].v[w] = mesh->zvol[z];
+
+            double r = rinit;
+            double e = einit;
+            if (!subrgn.empty() &&
+                    zxz.x > (subrgn[0] - eps) &&
+                    zxz.x < (subrgn[1] + eps) &&
+                    zxz.y > (subrgn[2] - eps) &&
+                    zxz.y < (subrgn[3] + eps)) {
+                r = rinitsub;
+                e = einitsub;
+            }
+            zr[z].v[w] = r;
+            ze[z].v[w] = e;
+            zwrate[z].v[w] = 0.;
+            zm[z].v[w] = r * mesh->zvol[z];
+            zetot[z].v[w] = e * zm[z].v[w];
+        }
+
+        for (int p = 0; p < nump; ++p) {
+            double2 u(0., 0.);
+            if (uinitradial != 0.) {
+                double pmag = length(mesh->px[p]);
+                if (pmag > eps)
+                    u = uinitradial * mesh->px[p] / pmag;
+            }
+            pu[p].x.v[w] = u.x;
+            pu[p].y.v[w] = u.y;
+        }
+    }  // for w
+
+}
+
+
+template <int W>
+void HydroLanes<W>::run() {
+
+    const RunOp<W> op = { this };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <int W>
+template <typename SM>
+void HydroLanes<W>::run(const SM sm) {
+
+    cycle = 0;
+    while (retireLanes(sm)) {
+        cycle += 1;
+        calcGlobalDt();
+        doCycle(sm);
+        time += dt;
+    }
+
+}
+
+
+template <int W>
+int64_t HydroLanes<W>::zones() const {
+    return mesh->numz;
+}
+
+
+template <int W>
+template <typename SM>
+bool HydroLanes<W>::retireLanes(const SM sm) {
+
+    const int numz = mesh->numz;
+
+    for (int w = 0; w < W; ++w) {
+        const int m = lanemem[w];
+        if (m < 0 || (cycle < cstop[w] && time.v[w] < tstop.v[w]))
+            continue;
+
+        Result& r = results[m];
+        r.cycle = cycle;
+        r.time = time.v[w];
+        calcEnergyCheck(sm, w, r.ei, r.ek);
+
+        // final mesh output, if requested
+        double* zrw = Memory::alloc<double>(numz, "lane output");
+        double* zew = Memory::alloc<double>(numz, "lane output");
+        double* zpw = Memory::alloc<double>(numz, "lane output");
+        for (int z = 0; z < numz; ++z) {
+            zrw[z] = zr[z].v[w];
+            zew[z] = ze[z].v[w];
+            zpw[z] = zp[z].v[w];
+        }
+        mesh->write(names[m], cycle, time.v[w], zrw, zew, zpw);
+        Memory::free(zrw);
+        Memory::free(zew);
+        Memory::free(zpw);
+
+        lanemem[w] = -1;
+    }
+
+    int wrun = -1;
+    for (int w = 0; w < W && wrun < 0; ++w)
+        if (lanemem[w] >= 0) wrun = w;
+    if (wrun < 0) return false;
+
+    // unneeded lanes follow a running lane, so that they
+    // never run past its stopping point
+    for (int w = 0; w < W; ++w) {
+        if (lanemem[w] >= 0 || lanemem[lanesrc[w]] >= 0) continue;
+        copyLane(wrun, w);
+        lanesrc[w] = wrun;
+    }
+    return true;
+
+}
+
+
+template <int W>
+void HydroLanes<W>::copyLane(const int from, const int to) {
+
+    const int nump = mesh->nump;
+    const int nume = mesh->nume;
+    const int numz = mesh->numz;
+    const int nums = mesh->nums;
+
+    struct {
+        d2W* ptr;
+        int n;
+    } fv[] = { { px, nump }, { px0, nump }, { pxp, nump },
+            { pu, nump }, { pu0, nump }, { pap, nump }, { pf, nump },
+            { ex, nume }, { exp, nume }, { zx, numz }, { zxp, numz },
+            { ssurfp, nums }, { sfp, nums }, { sfq, nums },
+            { sft, nums }, { cftot, nums } };
+    struct {
+        dW* ptr;
+        int n;
+    } fs[] = { { pmaswt, nump }, { elen, nume },
+            { zarea, numz }, { zvol, numz }, { zareap, numz },
+            { zvolp, numz }, { zvol0, numz }, { zdl, numz },
+            { zm, numz }, { zr, numz }, { zrp, numz }, { ze, numz },
+            { zetot, numz }, { zw, numz }, { zwrate, numz },
+            { zp, numz }, { zss, numz }, { zdu, numz },
+            { sarea, nums }, { svol, nums }, { sareap, nums },
+            { svolp, nums }, { cmaswt, nums } };
+    dW* params[] = { &cfl, &cflv, &gamma, &ssmin, &alfa, &qgamma,
+            &q1, &q2, &dtmax, &dtinit, &dtfac, &tstop, &time, &dt,
+            &dtlast, &dtrec };
+
+    // arrays that are not kept are NULL
+    for (int i = 0; i < sizeof(fv) / sizeof(fv[0]); ++i) {
+        d2W* f = fv[i].ptr;
+        if (f == NULL) continue;
+        for (int j = 0; j < fv[i].n; ++j) {
+            f[j].x.v[to] = f[j].x.v[from];
+            f[j].y.v[to] = f[j].y.v[from];
+        }
+    }
+    for (int i = 0; i < sizeof(fs) / sizeof(fs[0]); ++i) {
+        dW* f = fs[i].ptr;
+        if (f == NULL) continue;
+        for (int j = 0; j < fs[i].n; ++j)
+            f[j].v[to] = f[j].v[from];
+    }
+
+    for (int i = 0; i < sizeof(params) / sizeof(params[0]); ++i)
+        params[i]->v[to] = params[i]->v[from];
+    cstop[to] = cstop[from];
+
+}
+
+
+template <int W>
+void HydroLanes<W>::calcGlobalDt() {
+
+    // same limits as Driver::calcGlobalDt, for each lane
+    for (int w = 0; w < W; ++w) {
+        double& dtw = dt.v[w];
+        dtlast.v[w] = dtw;
+        dtw = dtmax.v[w];
+        if (cycle == 1) {
+            if (dtinit.v[w] < dtw) dtw = dtinit.v[w];
+        } else {
+            double dtrecover = dtfac.v[w] * dtlast.v[w];
+            if (dtrecover < dtw) dtw = dtrecover;
+        }
+        if ((tstop.v[w] - time.v[w]) < dtw) dtw = tstop.v[w] - time.v[w];
+        if (dtrec.v[w] < dtw) dtw = dtrec.v[w];
+    }
+
+}
+
+
+template <int W>
+template <typename SM>
+void HydroLanes<W>::doCycle(const SM sm) {
+
+    const int numpch = mesh->numpch;
+    const int numsch = mesh->numsch;
+    const int numzch = mesh->numzch;
+    const double* smf = mesh->smf;
+
+    #pragma omp parallel for schedule(static)
+    for (int pch = 0; pch < numpch; ++pch) {
+        int pfirst = mesh->pchpfirst[pch];
+        int plast = mesh->pchplast[pch];
+
+        // save off point variable values from previous cycle
+        copy(&px[pfirst], &px[plast], &px0[pfirst]);
+        copy(&pu[pfirst], &pu[plast], &pu0[pfirst]);
+
+        // ===== Predictor step =====
+        // 1. advance mesh to center of time step
+        Hydro::advPosHalf<FT>(px0, pu0, dt, pxp, pfirst, plast);
+    }  // for pch
+
+    #pragma omp parallel for schedule(static)
+    for (int sch = 0; sch < numsch; ++sch) {
+        int sfirst = mesh->schsfirst[sch];
+        int slast = mesh->schslast[sch];
+        int zfirst = mesh->schzfirst[sch];
+        int zlast = mesh->schzlast[sch];
+
+        // save off zone variable values from previous cycle
+        copy(&zvol[zfirst], &zvol[zlast], &zvol0[zfirst]);
+
+        // 1a. compute new mesh geometry
+        if (mesh->leanmem) {
+            mesh->calcGeomLean<FT>(sm, pxp, exp, zxp, zareap, zvolp, elen,
+                    zdl, sfirst, slast);
+        } else if (mesh->fusedgeom) {
+            mesh->calcGeomFused<FT>(sm, pxp, exp, zxp, sareap, svolp,
+                    zareap, zvolp, ssurfp, elen, zdl, sfirst, slast);
+        } else {
+            mesh->calcCtrs<FT>(sm, pxp, exp, zxp, sfirst, slast);
+            mesh->calcVols<FT>(sm, pxp, zxp, sareap, svolp, zareap, zvolp,
+                    sfirst, slast);
+            mesh->calcSurfVecs<FT>(sm, zxp, exp, ssurfp, sfirst, slast);
+            mesh->calcEdgeLen<FT>(sm, pxp, elen, sfirst, slast);
+            mesh->calcCharLen<FT>(sm, sareap, elen, zdl, sfirst, slast);
+        }
+
+        // 2. compute point masses
+        Hydro::calcRho<FT>(zm, zvolp, zrp, zfirst, zlast);
+        Hydro::calcCrnrMass<FT>(sm, zrp, zareap, smf, cmaswt,
+                sfirst, slast);
+
+        // 3. compute material state (half-advanced)
+        PolyGas::calcStateAtHalf<FT>(gamma, ssmin, zr, zvolp, zvol0, ze,
+                zwrate, zm, dt, zp, zss, zfirst, zlast);
+
+        // 4. compute forces
+        if (fusedforce) {
+            calcQCSForce(sm, sfirst, slast);
+            if (mesh->leanmem)
+                Hydro::calcCrnrForceLean<FT>(sm, alfa, ssmin, zp, zareap,
+                        zrp, zss, smf, pxp, exp, zxp, sfq, cftot,
+                        sfirst, slast);
+            else
+                Hydro::calcCrnrForceFused<FT>(sm, alfa, ssmin, zp, zareap,
+                        zrp, zss, sareap, smf, ssurfp, sfq, cftot,
+                        sfirst, slast);
+        } else {
+            PolyGas::calcForce<FT>(sm, zp, ssurfp, sfp, sfirst, slast);
+            TTS::calcForce<FT>(sm, alfa, ssmin, zareap, zrp, zss, sareap,
+                    smf, ssurfp, sft, sfirst, slast);
+            calcQCSForce(sm, sfirst, slast);
+            Hydro::sumCrnrForce<FT>(sm, sfp, sfq, sft, cftot,
+                    sfirst, slast);
+        }
+    }  // for sch
+    mesh->checkBadSides();
+
+    // sum corner masses, forces to points
+    mesh->sumToPoints(cmaswt, pmaswt);
+    mesh->sumToPoints(cftot, pf);
+
+    #pragma omp parallel for schedule(static)
+    for (int pch = 0; pch < numpch; ++pch) {
+        int pfirst = mesh->pchpfirst[pch];
+        int plast = mesh->pchplast[pch];
+
+        // 4a. apply boundary conditions
+        for (int i = 0; i < bcs.size(); ++i) {
+            int bfirst = bcs[i]->pchbfirst[pch];
+            int blast = bcs[i]->pchblast[pch];
+            bcs[i]->applyFixedBC<FT>(pu0, pf, bfirst, blast);
+        }
+
+        // 5. compute accelerations
+        Hydro::calcAccel<FT>(pf, pmaswt, pap, pfirst, plast);
+
+        // ===== Corrector step =====
+        // 6. advance mesh to end of time step
+        Hydro::advPosFull<FT>(px0, pu0, pap, dt, px, pu, pfirst, plast);
+    }  // for pch
+
+    dtrec = 1.e99;
+
+    #pragma omp parallel for schedule(static)
+    for (int sch = 0; sch < numsch; ++sch) {
+        int sfirst = mesh->schsfirst[sch];
+        int slast = mesh->schslast[sch];
+        int zfirst = mesh->schzfirst[sch];
+        int zlast = mesh->schzlast[sch];
+
+        // 6a. compute new mesh geometry
+        if (mesh->leanmem) {
+            mesh->calcZoneGeom<FT>(sm, px, zx, zarea, zvol, sfirst, slast);
+        } else {
+            mesh->calcCtrs<FT>(sm, px, ex, zx, sfirst, slast);
+            mesh->calcVols<FT>(sm, px, zx, sarea, svol, zarea, zvol,
+                    sfirst, slast);
+        }
+
+        // 7. compute work
+        fill(&zw[zfirst], &zw[zlast], dW(0.));
+        if (fusedforce)
+            Hydro::calcWork<FT>(sm, sfq, NULL, pu0, pu, pxp, dt, zw, zetot,
+                    sfirst, slast);
+        else
+            Hydro::calcWork<FT>(sm, sfp, sfq, pu0, pu, pxp, dt, zw, zetot,
+                    sfirst, slast);
+    }  // for sch
+    mesh->checkBadSides();
+
+    #pragma omp parallel for schedule(static)
+    for (int zch = 0; zch < numzch; ++zch) {
+        int zfirst = mesh->zchzfirst[zch];
+        int zlast = mesh->zchzlast[zch];
+
+        // 7a. compute work rate
+        Hydro::calcWorkRate<FT>(zvol0, zvol, zw, zp, dt, zwrate,
+                zfirst, zlast);
+
+        // 8. update state variables
+        Hydro::calcEnergy<FT>(zetot, zm, ze, zfirst, zlast);
+        Hydro::calcRho<FT>(zm, zvol, zr, zfirst, zlast);
+
+        // 9.  compute timestep for next cycle
+        calcDtHydro(zfirst, zlast);
+    }  // for zch
+
+}
+
+
+template <int W>
+template <typename SM>
+void HydroLanes<W>::calcQCSForce(
+        const SM sm,
+        const int sfirst,
+        const int slast) {
+
+    const int nums = mesh->nums;
+    const int numz = mesh->numz;
+    const int cfirst = sfirst;
+    const int clast = slast;
+    const int zfirst = sm.zone(sfirst);
+    const int zlast = (slast < nums ? sm.zone(slast) : numz);
+
+    Memory::ScratchScope scope;
+    dW* c0area = FT::scratch(clast - cfirst);
+    dW* c0evol = FT::scratch(clast - cfirst);
+    dW* c0du = FT::scratch(clast - cfirst);
+    dW* c0div = FT::scratch(clast - cfirst);
+    dW* c0cos = FT::scratch(clast - cfirst);
+    d2W* c0qe = FT::scratch2(2 * (clast - cfirst));
+    d2W* z0uc = FT::scratch2(zlast - zfirst);
+
+    // [2] corner divergence and related quantities
+    QCS::calcZoneVel<FT>(sm, pu, z0uc, sfirst, slast, zfirst, zlast);
+    QCS::calcCornerDiv<FT>(sm, pu, pxp, exp, zxp, z0uc, elen,
+            c0area, c0div, c0evol, c0du, c0cos, sfirst, slast, zfirst);
+
+    // [4] Q vector for each corner
+    QCS::calcQCnForce<FT>(sm, qgamma, q1, q2, pu, zrp, zss, elen,
+            c0div, c0du, c0evol, c0qe, sfirst, slast);
+
+    // [5] Q forces
+    QCS::setForce<FT>(sm, elen, c0area, c0qe, c0cos, sfq, sfirst, slast);
+
+    // [6] velocity difference for timestep
+    QCS::setVelDiff<FT>(sm, q1, q2, pxp, pu, zss, elen, zdu,
+            sfirst, slast, zfirst, zlast);
+
+}
+
+
+template <int W>
+void HydroLanes<W>::calcDtHydro(
+        const int zfirst,
+        const int zlast) {
+
+    dW dtcour, dtvol;
+    typename FT::index zmin, zmax;
+    Hydro::calcDtCourant<FT>(cfl, zdu, zss, zdl, dtcour, zmin,
+            zfirst, zlast);
+    Hydro::calcDtVolume<FT>(cflv, zvol, zvol0, dt, dtvol, zmax,
+            zfirst, zlast);
+
+    // as in Hydro::calcDtHydro, for each lane
+    for (int w = 0; w < W; ++w) {
+        double dtchunk = 1.e99;
+        if (dtcour.v[w] < dtchunk) dtchunk = dtcour.v[w];
+        if (dtvol.v[w] < dtchunk) dtchunk = dtvol.v[w];
+        if (dtchunk < dtrec.v[w]) {
+            #pragma omp critical
+            {
+                // redundant test needed to avoid race condition
+                if (dtchunk < dtrec.v[w]) dtrec.v[w] = dtchunk;
+            }
+        }
+    }
+
+}
+
+
+template <int W>
+template <typename SM>
+void HydroLanes<W>::calcEnergyCheck(
+        const SM sm,
+        const int w,
+        double& ei,
+        double& ek) {
+
+    // same sums, in the same order, as Hydro::calcEnergyCheck
+    // on one thread
+    dW eisum, eksum;
+    for (int sch = 0; sch < mesh->numsch; ++sch) {
+        int sfirst = mesh->schsfirst[sch];
+        int slast = mesh->schslast[sch];
+        int zfirst = mesh->schzfirst[sch];
+        int zlast = mesh->schzlast[sch];
+
+        dW eichunk, ekchunk;
+        Hydro::sumEnergy<FT>(sm, zetot, zarea, zvol, zm, mesh->smf,
+                px, pu, eichunk, ekchunk, zfirst, zlast, sfirst, slast);
+        eisum += eichunk;
+        eksum += ekchunk;
+    }
+    ei = eisum.v[w];
+    ek = eksum.v[w];
+
+}
+
+
+template class HydroLanes<2>;
+template class HydroLanes<4>;
+template class HydroLanes<8>;
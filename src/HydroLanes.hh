@@ -0,0 +1,169 @@
+/*
+ * HydroLanes.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef HYDROLANES_HH_
+#define HYDROLANES_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "FieldTypes.hh"
+
+// forward declarations
+class InputFile;
+class Timer;
+class Mesh;
+class HydroBC;
+
+
+// Class HydroLanes runs a group of problems that share a mesh and
+// differ only in their parameters, in lockstep on one mesh.  Each
+// field stores the values of all problems ("lanes") at a mesh
+// element together, so each mapping lookup in a kernel serves all
+// lanes and the inner loop over lanes can be vectorized.  The
+// kernels are those of the Mesh, Hydro and force classes, with
+// the FieldsLanes field types (see FieldTypes.hh), so the
+// arithmetic in each lane is the same as for one problem.  A lane
+// whose problem has finished becomes a copy of a running lane, so
+// that it keeps doing valid work until the whole group is done.
+
+class HydroLanesBase {
+public:
+
+    // final state of one problem
+    struct Result {
+        int cycle;                 // final cycle
+        double time;               // final simulation time
+        double ei, ek;             // final internal, kinetic energy
+    };
+
+    std::vector<Result> results;   // results, one per problem
+
+    virtual ~HydroLanesBase() {}
+
+    virtual void run() = 0;
+
+    // number of zones in the mesh
+    virtual int64_t zones() const = 0;
+
+    // is lane width supported?
+    static bool validWidth(const int width);
+
+    // do two problems have the same mesh and boundaries, so that
+    // they can run in the same group?
+    static bool sameMesh(const InputFile& inp1, const InputFile& inp2);
+
+    // create object for a group of up to 'width' problems
+    static HydroLanesBase* create(
+            const int width,
+            const std::vector<const InputFile*>& inps,
+            const std::vector<std::string>& names);
+
+};  // class HydroLanesBase
+
+
+template <int W>
+class HydroLanes : public HydroLanesBase {
+public:
+
+    typedef FieldsLanes<W> FT;
+    typedef typename FT::real dW;
+    typedef typename FT::real2 d2W;
+
+    // associated objects; mesh provides the maps and chunks
+    Timer* timer;
+    Mesh* mesh;
+    std::vector<HydroBC*> bcs;
+    bool fusedforce;               // as in Hydro
+
+    int nummem;                    // number of problems
+    std::vector<std::string> names;  // problem names
+    int lanemem[W];                // problem in each lane, or -1 if
+                                   // the lane is no longer needed
+    int lanesrc[W];                // lane each unneeded lane copies
+
+    // parameters, one value for each lane
+    dW cfl, cflv;                  // Courant, volume change factors
+    dW gamma, ssmin;               // PolyGas and TTS parameters
+    dW alfa;                       // TTS parameter
+    dW qgamma, q1, q2;             // QCS parameters
+    dW dtmax, dtinit, dtfac;
+    dW tstop;
+    int cstop[W];
+
+    int cycle;                     // simulation cycle number
+    dW time;                       // simulation time
+    dW dt;                         // current timestep
+    dW dtlast;                     // previous timestep
+    dW dtrec;                      // maximum timestep for hydro
+
+    // point, edge and zone fields, as in Mesh and Hydro; those
+    // that Mesh and Hydro do not keep (see leanmem, fusedforce)
+    // are NULL
+    d2W *px, *px0, *pxp, *pu, *pu0, *pap, *pf;
+    d2W *ex, *exp, *zx, *zxp;
+    d2W *ssurfp, *sfp, *sfq, *sft, *cftot;
+    dW *sarea, *svol, *sareap, *svolp;
+    dW *zarea, *zvol, *zareap, *zvolp, *zvol0;
+    dW *elen, *zdl, *cmaswt, *pmaswt;
+    dW *zm, *zr, *zrp, *ze, *zetot, *zw, *zwrate, *zp, *zss, *zdu;
+
+    HydroLanes(
+            const std::vector<const InputFile*>& inps,
+            const std::vector<std::string>& nms);
+    ~HydroLanes();
+
+    void init(const std::vector<const InputFile*>& inps);
+
+    // chooses the side map for the mesh, and runs with it
+    virtual void run();
+    template <typename SM>
+    void run(const SM sm);
+
+    virtual int64_t zones() const;
+
+    // record results for lanes that have reached their stopping
+    // point, and make unneeded lanes copy a running lane; returns
+    // false when no lanes are still running
+    template <typename SM>
+    bool retireLanes(const SM sm);
+
+    void copyLane(const int from, const int to);
+
+    void calcGlobalDt();
+
+    // the steps of Hydro::doCycle, for all lanes
+    template <typename SM>
+    void doCycle(const SM sm);
+
+    // the steps of QCS::calcForce, for all lanes
+    template <typename SM>
+    void calcQCSForce(
+            const SM sm,
+            const int sfirst,
+            const int slast);
+
+    void calcDtHydro(
+            const int zfirst,
+            const int zlast);
+
+    template <typename SM>
+    void calcEnergyCheck(
+            const SM sm,
+            const int w,
+            double& ei,
+            double& ek);
+
+};  // class HydroLanes
+
+
+#endif /* HYDROLANES_HH_ */
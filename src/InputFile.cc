@@ -107,3 +107,33 @@ vector<double> InputFile::getDoubleList(
     while (iss >> val) vallist.push_back(val);
     return vallist;
 }
+
+
+vector<string> InputFile::getStringList(
+        const string& key,
+        const vector<string>& dflt) const {
+    pairstype::const_iterator itr = pairs.find(key);
+    if (itr == pairs.end())
+        return dflt;
+    istringstream iss(itr->second);
+    vector<string> vallist;
+    string val;
+    while (iss >> val) vallist.push_back(val);
+    return vallist;
+}
+
+
+vector<string> InputFile::getKeys(const string& prefix) const {
+    vector<string> keys;
+    for (pairstype::const_iterator itr = pairs.lower_bound(prefix);
+            itr != pairs.end() &&
+            itr->first.compare(0, prefix.size(), prefix) == 0;
+            ++itr)
+        keys.push_back(itr->first);
+    return keys;
+}
+
+
+void InputFile::set(const string& key, const string& val) {
+    pairs[key] = val;
+}
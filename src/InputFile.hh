@@ -29,6 +29,15 @@ public:
     std::vector<double> getDoubleList(
             const std::string& key,
             const std::vector<double>& dflt) const;
+    std::vector<std::string> getStringList(
+            const std::string& key,
+            const std::vector<std::string>& dflt) const;
+
+    // list all keys starting with a given prefix
+    std::vector<std::string> getKeys(const std::string& prefix) const;
+
+    // add a key-value pair, or replace an existing value
+    void set(const std::string& key, const std::string& val);
 
 private:
     typedef std::map<std::string, std::string> pairstype;
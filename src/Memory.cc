@@ -0,0 +1,406 @@
+/*
+ * Memory.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Memory.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#if defined(_OPENMP) && defined(__INTEL_COMPILER)
+#include <omp.h>
+#endif
+
+using namespace std;
+
+
+namespace {
+
+size_t align = 64;
+Memory::PagePolicy policy = Memory::PAGES_NORMAL;
+
+// a live array
+struct Block {
+    size_t bytes;                  // bytes requested
+    int field;                     // index in fields
+    bool counted;                  // counted in its field? (see
+                                   // replaceBytes)
+    size_t hugebytes;              // bytes on huge pages, if any
+    bool hugetlb;                  // huge pages from the pool?
+};
+
+// every live array, so that freeBytes can account for it and
+// tell how it was allocated
+map<void*, Block> blocks;
+vector<Memory::Usage> fields;
+map<string, int> fieldindex;
+Memory::Usage total;
+double thpbytes = 0., hugetlbbytes = 0.;
+int64_t numfallback = 0;
+
+void addBlock(void* p, const Block& b0, const char* name) {
+
+    Block b = b0;
+    const string fname = (name ? name : "other");
+    #pragma omp critical (memoryblocks)
+    {
+        map<string, int>::iterator it = fieldindex.find(fname);
+        if (it == fieldindex.end()) {
+            Memory::Usage u;
+            u.name = fname;
+            u.numarrays = 0;
+            u.bytes = u.peak = 0.;
+            it = fieldindex.insert(make_pair(fname,
+                    (int) fields.size())).first;
+            fields.push_back(u);
+        }
+        b.field = it->second;
+        blocks[p] = b;
+        Memory::Usage* us[2] = { &fields[b.field], &total };
+        for (int i = 0; i < 2; ++i) {
+            us[i]->numarrays += 1;
+            us[i]->bytes += b.bytes;
+            us[i]->peak = max(us[i]->peak, us[i]->bytes);
+        }
+        if (b.hugetlb)
+            hugetlbbytes += b.hugebytes;
+        else
+            thpbytes += b.hugebytes;
+    }
+
+}
+
+// default huge page size, from /proc/meminfo
+size_t hugePageSize() {
+    static size_t hsize = 0;
+    if (hsize > 0) return hsize;
+    hsize = 2 << 20;
+    FILE* f = fopen("/proc/meminfo", "r");
+    if (f == NULL) return hsize;
+    char line[256];
+    unsigned long kb;
+    while (fgets(line, sizeof(line), f) != NULL)
+        if (sscanf(line, "Hugepagesize: %lu kB", &kb) == 1)
+            hsize = kb * 1024;
+    fclose(f);
+    return hsize;
+}
+
+void* allocAligned(const size_t bytes, const size_t a) {
+#if defined(_OPENMP) && defined(__INTEL_COMPILER)
+    return kmp_aligned_malloc(bytes, a);
+#else
+    void* p = NULL;
+    if (posix_memalign(&p, a, bytes) != 0) return NULL;
+    return p;
+#endif
+}
+
+void freeAligned(void* p) {
+#if defined(_OPENMP) && defined(__INTEL_COMPILER)
+    kmp_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+}  // namespace
+
+
+void Memory::setPolicy(const size_t a, const PagePolicy pages) {
+    align = a;
+    policy = pages;
+    // look up the huge page size now, outside any parallel region
+    hugePageSize();
+}
+
+
+bool Memory::parsePolicy(const char* name, PagePolicy& pages) {
+    if (strcmp(name, "none") == 0) pages = PAGES_NORMAL;
+    else if (strcmp(name, "thp") == 0) pages = PAGES_THP;
+    else if (strcmp(name, "hugetlb") == 0) pages = PAGES_HUGETLB;
+    else return false;
+    return true;
+}
+
+
+const char* Memory::policyName(const PagePolicy pages) {
+    switch (pages) {
+    case PAGES_THP:     return "thp";
+    case PAGES_HUGETLB: return "hugetlb";
+    default:            return "none";
+    }
+}
+
+
+Memory::PagePolicy Memory::getPolicy() {
+    return policy;
+}
+
+
+void* Memory::allocBytes(const size_t bytes, const char* name) {
+
+    Block b;
+    b.bytes = bytes;
+    b.counted = true;
+    b.hugebytes = 0;
+    b.hugetlb = false;
+
+    // malloc(0) may return NULL; keep every array distinct
+    const size_t n = max(bytes, (size_t) 1);
+    const size_t hsize = hugePageSize();
+    void* p = NULL;
+    if (policy == PAGES_NORMAL || n < hsize) {
+        p = allocAligned(n, align);
+        if (p == NULL) return NULL;
+        addBlock(p, b, name);
+        return p;
+    }
+
+    // round up to whole huge pages, so no other array shares them
+    b.hugebytes = (n + hsize - 1) / hsize * hsize;
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (policy == PAGES_HUGETLB) {
+        p = mmap(NULL, b.hugebytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) p = NULL;
+        b.hugetlb = (p != NULL);
+    }
+#endif
+    if (p == NULL) {
+        p = allocAligned(b.hugebytes, max(hsize, align));
+        if (p == NULL) return NULL;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        madvise(p, b.hugebytes, MADV_HUGEPAGE);
+#endif
+        if (policy == PAGES_HUGETLB) {
+            #pragma omp atomic
+            numfallback += 1;
+        }
+    }
+    addBlock(p, b, name);
+    return p;
+
+}
+
+
+void Memory::freeBytes(void* ptr) {
+
+    if (ptr == NULL) return;
+    bool found = false;
+    Block b;
+    #pragma omp critical (memoryblocks)
+    {
+        map<void*, Block>::iterator it = blocks.find(ptr);
+        if (it != blocks.end()) {
+            found = true;
+            b = it->second;
+            if (b.counted) {
+                fields[b.field].numarrays -= 1;
+                fields[b.field].bytes -= b.bytes;
+                total.numarrays -= 1;
+                total.bytes -= b.bytes;
+            }
+            if (b.hugetlb)
+                hugetlbbytes -= b.hugebytes;
+            else
+                thpbytes -= b.hugebytes;
+            blocks.erase(it);
+        }
+    }
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (found && b.hugetlb) {
+        munmap(ptr, b.hugebytes);
+        return;
+    }
+#endif
+    freeAligned(ptr);
+
+}
+
+
+void* Memory::replaceBytes(void* ptr, const size_t bytes) {
+
+    // stop counting the old array first, so that the field's peak
+    // doesn't include both copies
+    string name = "other";
+    #pragma omp critical (memoryblocks)
+    {
+        map<void*, Block>::iterator it = blocks.find(ptr);
+        if (it != blocks.end() && it->second.counted) {
+            Block& b = it->second;
+            b.counted = false;
+            name = fields[b.field].name;
+            fields[b.field].numarrays -= 1;
+            fields[b.field].bytes -= b.bytes;
+            total.numarrays -= 1;
+            total.bytes -= b.bytes;
+        }
+    }
+    return allocBytes(bytes, name.c_str());
+
+}
+
+
+void Memory::getUsage(vector<Usage>& f, Usage& t) {
+
+    #pragma omp critical (memoryblocks)
+    {
+        f = fields;
+        t = total;
+        t.name = "total";
+    }
+
+}
+
+
+double Memory::getPeakRSS() {
+
+    // ru_maxrss is in kilobytes on Linux
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss * 1024.;
+
+}
+
+
+void Memory::getPageStats(
+        double& thpb,
+        double& hugetlbb,
+        int64_t& numfb) {
+
+    #pragma omp critical (memoryblocks)
+    {
+        thpb = thpbytes;
+        hugetlbb = hugetlbbytes;
+        numfb = numfallback;
+    }
+
+}
+
+
+namespace {
+
+// scratch arrays are aligned to cache lines
+const size_t scratchAlign = 64;
+
+struct Arena {
+    char* raw;                     // arena memory, as allocated
+    char* buf;                     // start of arena, aligned
+    size_t cap;                    // size of buf
+    size_t top;                    // bytes of buf in use
+    vector<void*> blocks;          // malloc'd arrays in use, in the
+                                   // order they were taken
+    vector<size_t> blocksize;      // sizes of blocks
+    size_t blockbytes;             // sum of blocksize
+    size_t peak;                   // most bytes ever in use at once
+    int64_t numarena;              // arrays taken from buf
+    int64_t numheap;               // arrays taken from malloc
+
+    Arena() : raw(NULL), buf(NULL), cap(0), top(0), blockbytes(0), peak(0),
+        numarena(0), numheap(0) {}
+};
+
+// every thread's arena, for getScratchStats
+vector<Arena*> arenas;
+
+Arena* myarena = NULL;
+#pragma omp threadprivate(myarena)
+
+inline Arena& getArena() {
+    if (myarena == NULL) {
+        myarena = new Arena;
+        #pragma omp critical (scratcharenas)
+        arenas.push_back(myarena);
+    }
+    return *myarena;
+}
+
+}  // namespace
+
+
+void* Memory::scratchBytes(const size_t bytes) {
+
+    Arena& a = getArena();
+    const size_t n = (bytes + scratchAlign - 1) & ~(scratchAlign - 1);
+    void* p;
+    if (a.top + n <= a.cap) {
+        p = a.buf + a.top;
+        a.top += n;
+        a.numarena += 1;
+    }
+    else {
+        p = alloc<char>(n, "scratch overflow");
+        a.blocks.push_back(p);
+        a.blocksize.push_back(n);
+        a.blockbytes += n;
+        a.numheap += 1;
+    }
+    a.peak = max(a.peak, a.top + a.blockbytes);
+    return p;
+
+}
+
+
+Memory::ScratchScope::ScratchScope() {
+
+    Arena& a = getArena();
+    top = a.top;
+    numblocks = a.blocks.size();
+
+}
+
+
+Memory::ScratchScope::~ScratchScope() {
+
+    Arena& a = getArena();
+    a.top = top;
+    while (a.blocks.size() > numblocks) {
+        free((char*) a.blocks.back());
+        a.blockbytes -= a.blocksize.back();
+        a.blocks.pop_back();
+        a.blocksize.pop_back();
+    }
+
+    // once the arena is empty, make it big enough for the most
+    // that has been needed at once
+    if (a.top == 0 && a.blocks.empty() && a.peak > a.cap) {
+        free(a.raw);
+        a.cap = a.peak;
+        a.raw = alloc<char>(a.cap + scratchAlign, "scratch arena");
+        a.buf = a.raw + (scratchAlign -
+                (size_t) a.raw % scratchAlign) % scratchAlign;
+    }
+
+}
+
+
+void Memory::getScratchStats(
+        int64_t& numarena,
+        int64_t& numheap,
+        double& maxbytes) {
+
+    numarena = 0;
+    numheap = 0;
+    maxbytes = 0.;
+    #pragma omp critical (scratcharenas)
+    for (int i = 0; i < (int) arenas.size(); ++i) {
+        numarena += arenas[i]->numarena;
+        numheap += arenas[i]->numheap;
+        maxbytes = max(maxbytes, (double) arenas[i]->cap);
+    }
+
+}
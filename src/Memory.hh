@@ -14,36 +14,125 @@
 #define MEMORY_HH_
 
 #include <cstdlib>
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
 
 
 // Namespace Memory provides functions to allocate and free memory.
-// Currently these are just wrappers around std::malloc and free,
-// but they are abstracted here to make it easier to replace them
-// if needed.
+// Arrays are aligned to the size set by setPolicy (64 bytes, one
+// cache line, by default), and arrays of at least one huge page may
+// be backed by huge pages, to cut TLB misses in the gathers of
+// large meshes:
+//     PAGES_NORMAL    ordinary pages (the default)
+//     PAGES_THP       transparent huge pages, requested with madvise
+//     PAGES_HUGETLB   pages from the kernel's huge page pool
+//                     (MAP_HUGETLB); if the pool can't supply an
+//                     array, it falls back to PAGES_THP
 
 namespace Memory {
 
+enum PagePolicy { PAGES_NORMAL, PAGES_THP, PAGES_HUGETLB };
+
+// set alignment (a power of 2, at least sizeof(void*)) and
+// page policy for arrays allocated after the call
+void setPolicy(const size_t align, const PagePolicy pages);
+
+// parse a page policy name (none, thp, hugetlb); returns false
+// if the name is unknown
+bool parsePolicy(const char* name, PagePolicy& pages);
+const char* policyName(const PagePolicy pages);
+PagePolicy getPolicy();
+
+// Every array is accounted to a field, named when it is allocated
+// (arrays allocated without a name go to field "other"); see
+// getUsage.
+void* allocBytes(const size_t bytes, const char* name = NULL);
+void freeBytes(void* ptr);
+
 template<typename T>
-inline T* alloc(const int count) {
-#if defined(_OPENMP) && defined(__INTEL_COMPILER)
-    return (T*) kmp_malloc(count * sizeof(T));
-#else
-    return (T*) std::malloc(count * sizeof(T));
-#endif
+inline T* alloc(const int count, const char* name = NULL) {
+    return (T*) allocBytes((size_t) count * sizeof(T), name);
 }
 
 template<typename T>
 inline void free(T* ptr) {
-#if defined(_OPENMP) && defined(__INTEL_COMPILER)
-    kmp_free(ptr);
-#else
-    std::free(ptr);
-#endif
+    freeBytes((void*) ptr);
 }
 
+// Allocate an array to take the place of ptr, in ptr's field.
+// From then on ptr is not counted in its field, so copying an
+// array to new memory doesn't raise the field's peak; ptr must
+// still be freed.
+void* replaceBytes(void* ptr, const size_t bytes);
+
+template<typename T>
+inline T* replace(T* ptr, const int count) {
+    return (T*) replaceBytes((void*) ptr, (size_t) count * sizeof(T));
+}
+
+// bytes of live arrays on transparent huge pages and on huge pages
+// from the pool, and the number of arrays that couldn't get pages
+// from the pool
+void getPageStats(
+        double& thpbytes,
+        double& hugetlbbytes,
+        int64_t& numfallback);
+
+// memory held by the arrays of one field
+struct Usage {
+    std::string name;
+    int numarrays;                 // live arrays
+    double bytes;                  // bytes in live arrays
+    double peak;                   // most bytes ever live at once
+};
+
+// usage of every field, in order of first allocation, and of all
+// fields together
+void getUsage(std::vector<Usage>& fields, Usage& total);
+
+// peak resident set size of this process, in bytes
+double getPeakRSS();
+
+
+// Scratch arrays are temporaries that live only for the duration of
+// one kernel call.  Each thread takes them from its own arena, which
+// grows to the largest amount its thread ever needs at once and is
+// then reused, so after the first cycle no malloc or free is done.
+// A ScratchScope marks the thread's arena when created, and gives
+// back every scratch array taken after the mark when destroyed;
+// scratch arrays are never freed individually.  If the arena is
+// full, a scratch array comes from malloc instead, and the arena is
+// enlarged the next time it is empty.
+
+void* scratchBytes(const size_t bytes);
+
+template<typename T>
+inline T* scratch(const int count) {
+    return (T*) scratchBytes(count * sizeof(T));
+}
+
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+private:
+    size_t top;                    // arena bytes in use at the mark
+    size_t numblocks;              // malloc'd arrays in use at the mark
+
+    // not copyable
+    ScratchScope(const ScratchScope&);
+    ScratchScope& operator=(const ScratchScope&);
+};
+
+// totals over the arenas of all threads:  scratch arrays taken from
+// an arena, and from malloc; largest arena size, in bytes
+void getScratchStats(
+        int64_t& numarena,
+        int64_t& numheap,
+        double& maxbytes);
+
 };  // namespace Memory
 
 #endif /* MEMORY_HH_ */
@@ -15,25 +15,194 @@
 #include <stdint.h>
 #include <cmath>
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "Vec2.hh"
 #include "Memory.hh"
 #include "Parallel.hh"
 #include "InputFile.hh"
 #include "GenMesh.hh"
+#include "MeshOrder.hh"
 #include "WriteXY.hh"
 #include "ExportGold.hh"
+#include "Timer.hh"
+#include "Checkpoint.hh"
+#include "SideMap.hh"
+#include "Numa.hh"
 
 using namespace std;
 
 
-Mesh::Mesh(const InputFile* inp) :
-    gmesh(NULL), egold(NULL), wxy(NULL) {
+namespace {
+
+// function objects for dispatchSideMap (see SideMap.hh):  each
+// calls a kernel's FieldsOne version with the side map given
+
+struct CalcCtrsOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    double2ptr ex;
+    double2ptr zx;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcCtrs<FieldsOne>(sm, px, ex, zx, sfirst, slast);
+    }
+};
+
+
+struct CalcVolsOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    const_double2ptr zx;
+    double* sarea;
+    double* svol;
+    double* zarea;
+    double* zvol;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcVols<FieldsOne>(sm, px, zx, sarea, svol, zarea, zvol, sfirst,
+                slast);
+    }
+};
+
+
+struct CalcSideFracsOp {
+    Mesh* mesh;
+    const double* sarea;
+    const double* zarea;
+    double* smf;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcSideFracs<FieldsOne>(sm, sarea, zarea, smf, sfirst, slast);
+    }
+};
+
+
+struct CalcSurfVecsOp {
+    Mesh* mesh;
+    const_double2ptr zx;
+    const_double2ptr ex;
+    double2ptr ssurf;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcSurfVecs<FieldsOne>(sm, zx, ex, ssurf, sfirst, slast);
+    }
+};
+
+
+struct CalcEdgeLenOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    double* elen;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcEdgeLen<FieldsOne>(sm, px, elen, sfirst, slast);
+    }
+};
+
+
+struct CalcCharLenOp {
+    Mesh* mesh;
+    const double* sarea;
+    const double* elen;
+    double* zdl;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcCharLen<FieldsOne>(sm, sarea, elen, zdl, sfirst, slast);
+    }
+};
+
+
+struct CalcGeomFusedOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    double2ptr ex;
+    double2ptr zx;
+    double* sarea;
+    double* svol;
+    double* zarea;
+    double* zvol;
+    double2ptr ssurf;
+    double* elen;
+    double* zdl;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcGeomFused<FieldsOne>(sm, px, ex, zx, sarea, svol, zarea,
+                zvol, ssurf, elen, zdl, sfirst, slast);
+    }
+};
+
+
+struct CalcGeomLeanOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    double2ptr ex;
+    double2ptr zx;
+    double* zarea;
+    double* zvol;
+    double* elen;
+    double* zdl;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcGeomLean<FieldsOne>(sm, px, ex, zx, zarea, zvol, elen, zdl,
+                sfirst, slast);
+    }
+};
+
+
+struct CalcZoneGeomOp {
+    Mesh* mesh;
+    const_double2ptr px;
+    double2ptr zx;
+    double* zarea;
+    double* zvol;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        mesh->calcZoneGeom<FieldsOne>(sm, px, zx, zarea, zvol, sfirst, slast);
+    }
+};
+
+}  // namespace
+
+
+Mesh::Mesh(const InputFile* inp, Timer* t, ChkptReader* cr) :
+    timer(t), gmesh(NULL), morder(NULL), egold(NULL), wxy(NULL) {
 
     using Parallel::mype;
 
-    chunksize = inp->getInt("chunksize", 0);
+    chunkauto = (inp->getString("chunksize", "") == "auto");
+    chunksize = (chunkauto ? 0 : inp->getInt("chunksize", 0));
     if (chunksize < 0) {
         if (mype == 0)
             cerr << "Error: bad chunksize " << chunksize << endl;
@@ -49,22 +218,75 @@ Mesh::Mesh(const InputFile* inp) :
 
     writexy = inp->getInt("writexy", 0);
     writegold = inp->getInt("writegold", 0);
+    quiet = inp->getInt("quiet", 0);
+    fusedgeom = inp->getInt("fusedgeom", 1);
+    uniformsides = inp->getInt("uniformsides", 1);
+    structured = inp->getInt("structured", 0);
+    numaplace = inp->getInt("numaplace", 1);
+    numapin = inp->getInt("numapin", 0);
+    numareport = inp->getInt("numareport", 0);
+    leanmem = inp->getInt("leanmem", 0);
+    if (leanmem && !fusedgeom) {
+        if (mype == 0)
+            cerr << "Error: leanmem requires fusedgeom" << endl;
+        exit(1);
+    }
+    leanbytes = 0.;
+
+    // set memory policy before any array is allocated; the policy
+    // is process-wide, so in a parallel region (an ensemble) the
+    // caller has already set it
+    bool inpar = false;
+#ifdef _OPENMP
+    inpar = omp_in_parallel();
+#endif
+    if (!inpar) setMemPolicy(inp);
+
+    // pin threads before any array is touched
+    if (numapin) numapin = Numa::pinThreads();
+    if (numaplace) Numa::useFreshPages();
 
     gmesh = new GenMesh(inp);
+    morder = new MeshOrder(inp);
     wxy = new WriteXY(this);
     egold = new ExportGold(this);
 
-    init();
+    if (cr)
+        initFromChkpt(*cr);
+    else
+        init();
 }
 
 
 Mesh::~Mesh() {
     delete gmesh;
+    delete morder;
     delete wxy;
     delete egold;
 }
 
 
+void Mesh::setMemPolicy(const InputFile* inp) {
+    using Parallel::mype;
+
+    const int memalign = inp->getInt("memalign", 64);
+    if (memalign < (int) sizeof(void*) || (memalign & (memalign - 1))) {
+        if (mype == 0)
+            cerr << "Error: memalign must be a power of 2, at least "
+                 << sizeof(void*) << endl;
+        exit(1);
+    }
+    Memory::PagePolicy pages;
+    string pagename = inp->getString("hugepages", "none");
+    if (!Memory::parsePolicy(pagename.c_str(), pages)) {
+        if (mype == 0)
+            cerr << "Error: bad hugepages " << pagename << endl;
+        exit(1);
+    }
+    Memory::setPolicy(memalign, pages);
+}
+
+
 void Mesh::init() {
 
     // generate mesh
@@ -76,13 +298,17 @@ void Mesh::init() {
             slavemstrpes, slavemstrcounts, slavepoints,
             masterslvpes, masterslvcounts, masterpoints);
 
+    // renumber zones and points, if requested
+    morder->reorder(nodepos, cellstart, cellsize, cellnodes,
+            slavepoints, masterpoints, zoneorig);
+
     nump = nodepos.size();
     numz = cellstart.size();
     nums = cellnodes.size();
     numc = nums;
 
     // copy cell sizes to mesh
-    znump = Memory::alloc<int>(numz);
+    znump = Memory::alloc<int>(numz, "znump");
     copy(cellsize.begin(), cellsize.end(), znump);
 
     // populate maps:
@@ -93,7 +319,11 @@ void Mesh::init() {
     cellsize.resize(0);
     cellnodes.resize(0);
     // now populate edge maps using side maps
-    initEdges();
+    if (gmesh->meshtype == "rect" && zoneorig.empty())
+        initEdgesRect(gmesh->nzx, gmesh->nzy);
+    else
+        initEdges();
+    initZoneSides();
 
     // populate chunk information
     initChunks();
@@ -116,26 +346,7 @@ void Mesh::init() {
     writeStats();
 
     // allocate remaining arrays
-    px = Memory::alloc<double2>(nump);
-    ex = Memory::alloc<double2>(nume);
-    zx = Memory::alloc<double2>(numz);
-    px0 = Memory::alloc<double2>(nump);
-    pxp = Memory::alloc<double2>(nump);
-    exp = Memory::alloc<double2>(nume);
-    zxp = Memory::alloc<double2>(numz);
-    sarea = Memory::alloc<double>(nums);
-    svol = Memory::alloc<double>(nums);
-    zarea = Memory::alloc<double>(numz);
-    zvol = Memory::alloc<double>(numz);
-    sareap = Memory::alloc<double>(nums);
-    svolp = Memory::alloc<double>(nums);
-    zareap = Memory::alloc<double>(numz);
-    zvolp = Memory::alloc<double>(numz);
-    zvol0 = Memory::alloc<double>(numz);
-    ssurfp = Memory::alloc<double2>(nums);
-    elen = Memory::alloc<double>(nume);
-    zdl = Memory::alloc<double>(numz);
-    smf = Memory::alloc<double>(nums);
+    initGeom();
 
     // do a few initial calculations
     #pragma omp parallel for schedule(static)
@@ -159,6 +370,232 @@ void Mesh::init() {
     }
     checkBadSides();
 
+    if (leanmem) dropLeanArrays();
+    placeArrays();
+
+}
+
+
+void Mesh::initFromChkpt(ChkptReader& cr) {
+
+    cr.read("nump", nump);
+    cr.read("nume", nume);
+    cr.read("numz", numz);
+    cr.read("nums", nums);
+    numc = nums;
+    cr.read("chunksize", chunksize);
+
+    znump = Memory::alloc<int>(numz, "znump");
+    mapsp1 = Memory::alloc<int>(nums, "mapsp1");
+    mapsp2 = Memory::alloc<int>(nums, "mapsp2");
+    mapsz  = Memory::alloc<int>(nums, "mapsz");
+    mapss3 = Memory::alloc<int>(nums, "mapss3");
+    mapss4 = Memory::alloc<int>(nums, "mapss4");
+    mapse  = Memory::alloc<int>(nums, "mapse");
+    cr.read("znump", znump, numz);
+    cr.read("mapsp1", mapsp1, nums);
+    cr.read("mapsp2", mapsp2, nums);
+    cr.read("mapsz", mapsz, nums);
+    cr.read("mapss3", mapss3, nums);
+    cr.read("mapss4", mapss4, nums);
+    cr.read("mapse", mapse, nums);
+    cr.read("zoneorig", zoneorig);
+    initZoneSides();
+
+    mappcoff = Memory::alloc<int>(nump + 1, "mappcoff");
+    mappc = Memory::alloc<int>(nums, "mappc");
+    cr.read("mappcoff", mappcoff, nump + 1);
+    cr.read("mappc", mappc, nums);
+
+    cr.read("schsfirst", schsfirst);
+    cr.read("schslast", schslast);
+    cr.read("schzfirst", schzfirst);
+    cr.read("schzlast", schzlast);
+    cr.read("pchpfirst", pchpfirst);
+    cr.read("pchplast", pchplast);
+    cr.read("zchzfirst", zchzfirst);
+    cr.read("zchzlast", zchzlast);
+    numsch = schsfirst.size();
+    numpch = pchpfirst.size();
+    numzch = zchzfirst.size();
+
+    if (Parallel::numpe > 1) {
+        cr.read("nummstrpe", nummstrpe);
+        cr.read("numslvpe", numslvpe);
+        cr.read("numprx", numprx);
+        cr.read("numslv", numslv);
+        mapmstrpepe = Memory::alloc<int>(nummstrpe, "mapmstrpepe");
+        mstrpenumslv = Memory::alloc<int>(nummstrpe, "mstrpenumslv");
+        mapmstrpeslv1 = Memory::alloc<int>(nummstrpe, "mapmstrpeslv1");
+        mapslvp = Memory::alloc<int>(numslv, "mapslvp");
+        mapslvpepe = Memory::alloc<int>(numslvpe, "mapslvpepe");
+        slvpenumprx = Memory::alloc<int>(numslvpe, "slvpenumprx");
+        mapslvpeprx1 = Memory::alloc<int>(numslvpe, "mapslvpeprx1");
+        mapprxp = Memory::alloc<int>(numprx, "mapprxp");
+        cr.read("mapmstrpepe", mapmstrpepe, nummstrpe);
+        cr.read("mstrpenumslv", mstrpenumslv, nummstrpe);
+        cr.read("mapmstrpeslv1", mapmstrpeslv1, nummstrpe);
+        cr.read("mapslvp", mapslvp, numslv);
+        cr.read("mapslvpepe", mapslvpepe, numslvpe);
+        cr.read("slvpenumprx", slvpenumprx, numslvpe);
+        cr.read("mapslvpeprx1", mapslvpeprx1, numslvpe);
+        cr.read("mapprxp", mapprxp, numprx);
+    }
+
+    writeStats();
+
+    initGeom();
+
+    // side mass fractions are fixed at their initial values,
+    // so they must be restored rather than recomputed
+    cr.read("px", px, nump);
+    cr.read("smf", smf, nums);
+
+    numsbad = 0;
+    #pragma omp parallel for schedule(static)
+    for (int sch = 0; sch < numsch; ++sch) {
+        int sfirst = schsfirst[sch];
+        int slast = schslast[sch];
+        calcCtrs(px, ex, zx, sfirst, slast);
+        calcVols(px, zx, sarea, svol, zarea, zvol, sfirst, slast);
+    }
+    checkBadSides();
+
+    if (leanmem) dropLeanArrays();
+    placeArrays();
+
+}
+
+
+void Mesh::writeChkpt(ChkptWriter& cw) {
+
+    // must stay in the same order as initFromChkpt
+    cw.add("nump", nump);
+    cw.add("nume", nume);
+    cw.add("numz", numz);
+    cw.add("nums", nums);
+    cw.add("chunksize", chunksize);
+
+    cw.add("znump", znump, numz);
+    cw.add("mapsp1", mapsp1, nums);
+    cw.add("mapsp2", mapsp2, nums);
+    cw.add("mapsz", mapsz, nums);
+    cw.add("mapss3", mapss3, nums);
+    cw.add("mapss4", mapss4, nums);
+    cw.add("mapse", mapse, nums);
+    cw.add("zoneorig", zoneorig);
+
+    cw.add("mappcoff", mappcoff, nump + 1);
+    cw.add("mappc", mappc, nums);
+
+    cw.add("schsfirst", schsfirst);
+    cw.add("schslast", schslast);
+    cw.add("schzfirst", schzfirst);
+    cw.add("schzlast", schzlast);
+    cw.add("pchpfirst", pchpfirst);
+    cw.add("pchplast", pchplast);
+    cw.add("zchzfirst", zchzfirst);
+    cw.add("zchzlast", zchzlast);
+
+    if (Parallel::numpe > 1) {
+        cw.add("nummstrpe", nummstrpe);
+        cw.add("numslvpe", numslvpe);
+        cw.add("numprx", numprx);
+        cw.add("numslv", numslv);
+        cw.add("mapmstrpepe", mapmstrpepe, nummstrpe);
+        cw.add("mstrpenumslv", mstrpenumslv, nummstrpe);
+        cw.add("mapmstrpeslv1", mapmstrpeslv1, nummstrpe);
+        cw.add("mapslvp", mapslvp, numslv);
+        cw.add("mapslvpepe", mapslvpepe, numslvpe);
+        cw.add("slvpenumprx", slvpenumprx, numslvpe);
+        cw.add("mapslvpeprx1", mapslvpeprx1, numslvpe);
+        cw.add("mapprxp", mapprxp, numprx);
+    }
+
+    cw.add("px", px, nump);
+    cw.add("smf", smf, nums);
+
+}
+
+
+void Mesh::writeState(ChkptWriter& cw) {
+
+    cw.add("px", px, nump);
+    if (!leanmem) {
+        cw.add("ex", ex, nume);
+        cw.add("sarea", sarea, nums);
+        cw.add("svol", svol, nums);
+    }
+    cw.add("zx", zx, numz);
+    cw.add("zarea", zarea, numz);
+    cw.add("zvol", zvol, numz);
+
+}
+
+
+void Mesh::setChunkSize(const int cs) {
+
+    chunksize = cs;
+    schsfirst.resize(0);
+    schslast.resize(0);
+    schzfirst.resize(0);
+    schzlast.resize(0);
+    pchpfirst.resize(0);
+    pchplast.resize(0);
+    zchzfirst.resize(0);
+    zchzlast.resize(0);
+    initChunks();
+
+}
+
+
+void Mesh::initGeom() {
+
+    px = Memory::alloc2(nump, "px");
+    ex = Memory::alloc2(nume, "ex");
+    zx = Memory::alloc2(numz, "zx");
+    px0 = Memory::alloc2(nump, "px0");
+    pxp = Memory::alloc2(nump, "pxp");
+    exp = Memory::alloc2(nume, "exp");
+    zxp = Memory::alloc2(numz, "zxp");
+    sarea = Memory::alloc<double>(nums, "sarea");
+    svol = Memory::alloc<double>(nums, "svol");
+    zarea = Memory::alloc<double>(numz, "zarea");
+    zvol = Memory::alloc<double>(numz, "zvol");
+    zareap = Memory::alloc<double>(numz, "zareap");
+    zvolp = Memory::alloc<double>(numz, "zvolp");
+    zvol0 = Memory::alloc<double>(numz, "zvol0");
+    elen = Memory::alloc<double>(nume, "elen");
+    zdl = Memory::alloc<double>(numz, "zdl");
+    smf = Memory::alloc<double>(nums, "smf");
+
+    // the middle-of-cycle side geometry is recomputed where it
+    // is used in lean memory mode
+    sareap = svolp = NULL;
+    ssurfp = double2ptr();
+    if (leanmem)
+        leanbytes += (2. * sizeof(double) + sizeof(double2)) * nums;
+    else {
+        sareap = Memory::alloc<double>(nums, "sareap");
+        svolp = Memory::alloc<double>(nums, "svolp");
+        ssurfp = Memory::alloc2(nums, "ssurfp");
+    }
+
+}
+
+
+void Mesh::dropLeanArrays() {
+
+    // ex, sarea and svol are needed to set up the mesh, but
+    // not in the hydro cycle (see calcZoneGeom)
+    Memory::free(ex);
+    Memory::free(sarea);
+    Memory::free(svol);
+    ex = double2ptr();
+    sarea = svol = NULL;
+    leanbytes += sizeof(double2) * (double) nume +
+            2. * sizeof(double) * nums;
+
 }
 
 
@@ -167,11 +604,11 @@ void Mesh::initSides(
         const vector<int>& cellsize,
         const vector<int>& cellnodes) {
 
-    mapsp1 = Memory::alloc<int>(nums);
-    mapsp2 = Memory::alloc<int>(nums);
-    mapsz  = Memory::alloc<int>(nums);
-    mapss3 = Memory::alloc<int>(nums);
-    mapss4 = Memory::alloc<int>(nums);
+    mapsp1 = Memory::alloc<int>(nums, "mapsp1");
+    mapsp2 = Memory::alloc<int>(nums, "mapsp2");
+    mapsz  = Memory::alloc<int>(nums, "mapsz");
+    mapss3 = Memory::alloc<int>(nums, "mapss3");
+    mapss4 = Memory::alloc<int>(nums, "mapss4");
 
     for (int z = 0; z < numz; ++z) {
         int sbase = cellstart[z];
@@ -195,7 +632,7 @@ void Mesh::initEdges() {
 
     vector<vector<int> > edgepp(nump), edgepe(nump);
 
-    mapse = Memory::alloc<int>(nums);
+    mapse = Memory::alloc<int>(nums, "mapse");
 
     int e = 0;
     for (int s = 0; s < nums; ++s) {
@@ -219,6 +656,72 @@ void Mesh::initEdges() {
 }
 
 
+void Mesh::initEdgesRect(const int nzx, const int nzy) {
+
+    mapse = Memory::alloc<int>(nums, "mapse");
+
+    // horizontal edges by row, then vertical edges by row
+    const int neh = nzx * (nzy + 1);
+    for (int j = 0; j < nzy; ++j) {
+        for (int i = 0; i < nzx; ++i) {
+            const int z = j * nzx + i;
+            mapse[4 * z]     = z;
+            mapse[4 * z + 1] = neh + z + j + 1;
+            mapse[4 * z + 2] = z + nzx;
+            mapse[4 * z + 3] = neh + z + j;
+        }
+    }
+    nume = neh + (nzx + 1) * nzy;
+
+}
+
+
+void Mesh::initZoneSides() {
+
+    zonesides = 0;
+    rectnzx = 0;
+    rectnzy = 0;
+    if (numz == 0) return;
+
+    // the layout is found whatever uniformsides is, since point
+    // sums use a rect grid even when side loops read the maps;
+    // only quadrilateral zones have specialized side loops
+    const int n = 4;
+    if (nums != n * numz) return;
+    for (int z = 0; z < numz; ++z)
+        if (znump[z] != n) return;
+    for (int s = 0; s < nums; ++s) {
+        int sz = s - s % n;
+        if (mapsz[s] != s / n ||
+                mapss3[s] != (s == sz ? s + n - 1 : s - 1) ||
+                mapss4[s] != (s == sz + n - 1 ? sz : s + 1))
+            return;
+    }
+    zonesides = n;
+
+    // the first zone's top right point gives the grid width;
+    // check every map against the structured rect formulas
+    const int nzx = mapsp1[2] - 2;
+    if (nzx <= 0 || numz % nzx != 0) return;
+    const int nzy = numz / nzx;
+    if (nump != (nzx + 1) * (nzy + 1) ||
+            nume != nzx * (nzy + 1) + (nzx + 1) * nzy)
+        return;
+    rectnzx = nzx;
+    rectnzy = nzy;
+    const SideMapRect sm(this);
+    for (int s = 0; s < nums; ++s) {
+        if (mapsp1[s] != sm.p1(s) || mapsp2[s] != sm.p2(s) ||
+                mapse[s] != sm.edge(s)) {
+            rectnzx = 0;
+            rectnzy = 0;
+            return;
+        }
+    }
+
+}
+
+
 void Mesh::initChunks() {
 
     if (chunksize == 0) chunksize = max(nump, nums);
@@ -264,29 +767,310 @@ void Mesh::initChunks() {
 
 
 void Mesh::initInvMap() {
-    mappcfirst = Memory::alloc<int>(nump);
-    mapccnext = Memory::alloc<int>(nums);
+    mappcoff = Memory::alloc<int>(nump + 1, "mappcoff");
+    mappc = Memory::alloc<int>(nums, "mappc");
 
-    vector<pair<int, int> > pcpair(nums);
+    // count corners at each point, then place them in corner
+    // order, so each point's corners are stored in ascending order
+    fill(mappcoff, mappcoff + nump + 1, 0);
     for (int c = 0; c < numc; ++c)
-        pcpair[c] = make_pair(mapsp1[c], c);
-    sort(pcpair.begin(), pcpair.end());
-    for (int i = 0; i < numc; ++i) {
-        int p = pcpair[i].first;
-        int c = pcpair[i].second;
-
-        if (i == 0) mappcfirst[p] = c;
-        else {
-            int pm = pcpair[i-1].first;
-            if (p != pm) mappcfirst[p] = c;
+        mappcoff[mapsp1[c] + 1] += 1;
+    for (int p = 0; p < nump; ++p)
+        mappcoff[p + 1] += mappcoff[p];
+    vector<int> pnext(mappcoff, mappcoff + nump);
+    for (int c = 0; c < numc; ++c) {
+        int p = mapsp1[c];
+        mappc[pnext[p]] = c;
+        pnext[p] += 1;
+    }
+}
+
+
+void Mesh::placeArrays() {
+
+    // an edge is first touched, in calcCtrs, by the first side
+    // chunk with a side on it
+    echfirst.assign(nume, -1);
+    for (int sch = 0; sch < numsch; ++sch) {
+        for (int s = schsfirst[sch]; s < schslast[sch]; ++s) {
+            int e = mapse[s];
+            if (echfirst[e] < 0) echfirst[e] = sch;
+        }
+    }
+
+    place("znump", znump, ENT_ZONE);
+    place("mapsp1", mapsp1, ENT_SIDE);
+    place("mapsp2", mapsp2, ENT_SIDE);
+    place("mapsz", mapsz, ENT_SIDE);
+    place("mapss3", mapss3, ENT_SIDE);
+    place("mapss4", mapss4, ENT_SIDE);
+    place("mapse", mapse, ENT_SIDE);
+    place("mappcoff", mappcoff, ENT_POINT, 1);
+    place("mappc", mappc, ENT_PCORNER);
+
+    place("px", px, ENT_POINT);
+    place("ex", ex, ENT_EDGE);
+    place("zx", zx, ENT_ZONE);
+    place("pxp", pxp, ENT_POINT);
+    place("exp", exp, ENT_EDGE);
+    place("zxp", zxp, ENT_ZONE);
+    place("px0", px0, ENT_POINT);
+    place("sarea", sarea, ENT_SIDE);
+    place("svol", svol, ENT_SIDE);
+    place("zarea", zarea, ENT_ZONE);
+    place("zvol", zvol, ENT_ZONE);
+    place("sareap", sareap, ENT_SIDE);
+    place("svolp", svolp, ENT_SIDE);
+    place("zareap", zareap, ENT_ZONE);
+    place("zvolp", zvolp, ENT_ZONE);
+    place("zvol0", zvol0, ENT_ZONE);
+    place("ssurfp", ssurfp, ENT_SIDE);
+    place("elen", elen, ENT_EDGE);
+    place("smf", smf, ENT_SIDE);
+    place("zdl", zdl, ENT_ZONE);
+
+}
+
+
+void Mesh::place(
+        const string& name,
+        int*& var,
+        const Entity ent,
+        const int extra) {
+    placeArray(name, var, ent, extra, 1);
+}
+
+
+void Mesh::place(
+        const string& name,
+        double*& var,
+        const Entity ent) {
+    placeArray(name, var, ent, 0, 1);
+}
+
+
+void Mesh::place(
+        const string& name,
+        double2ptr& var,
+        const Entity ent) {
+#ifdef USE_SOA
+    // x and y come from one allocation (see Memory::alloc2)
+    double* xy = var.x;
+    placeArray(name, xy, ent, 0, 2);
+    if (xy) var = double2ptr(xy, xy + entityCount(ent));
+#else
+    placeArray(name, var, ent, 0, 1);
+#endif
+}
+
+
+int Mesh::entityCount(const Entity ent) const {
+    switch (ent) {
+    case ENT_POINT:   return nump;
+    case ENT_EDGE:    return nume;
+    case ENT_ZONE:    return numz;
+    default:          return nums;
+    }
+}
+
+
+template <typename T>
+void Mesh::placeArray(
+        const string& name,
+        T*& var,
+        const Entity ent,
+        const int extra,
+        const int numcomp) {
+
+    if (var == NULL) return;
+    const int n = entityCount(ent);
+
+    if (numaplace) {
+        T* newvar = Memory::replace(var, numcomp * n + extra);
+        for (int c = 0; c < numcomp; ++c)
+            placeCopy(&var[c * n], &newvar[c * n], ent);
+        copy(&var[numcomp * n], &var[numcomp * n + extra],
+                &newvar[numcomp * n]);
+        Memory::free(var);
+        var = newvar;
+    }
+
+    Placed pl;
+    pl.name = name;
+    pl.ptr = (const char*) var;
+    pl.count = n;
+    pl.elembytes = sizeof(T);
+    pl.numcomp = numcomp;
+    pl.ent = ent;
+    int i = 0;
+    while (i < placed.size() && placed[i].name != name) ++i;
+    if (i < placed.size())
+        placed[i] = pl;
+    else
+        placed.push_back(pl);
+
+}
+
+
+template <typename T>
+void Mesh::placeCopy(
+        const T* src,
+        T* dst,
+        const Entity ent) {
+
+    // each loop has the same chunks and schedule as the
+    // corresponding loop in Hydro::doCycle
+    switch (ent) {
+    case ENT_POINT:
+        #pragma omp parallel for schedule(static)
+        for (int pch = 0; pch < numpch; ++pch) {
+            int pfirst = pchpfirst[pch];
+            int plast = pchplast[pch];
+            copy(&src[pfirst], &src[plast], &dst[pfirst]);
+        }
+        break;
+    case ENT_PCORNER:
+        #pragma omp parallel for schedule(static)
+        for (int pch = 0; pch < numpch; ++pch) {
+            int cfirst = mappcoff[pchpfirst[pch]];
+            int clast = mappcoff[pchplast[pch]];
+            copy(&src[cfirst], &src[clast], &dst[cfirst]);
+        }
+        break;
+    case ENT_ZONE:
+        #pragma omp parallel for schedule(static)
+        for (int sch = 0; sch < numsch; ++sch) {
+            int zfirst = schzfirst[sch];
+            int zlast = schzlast[sch];
+            copy(&src[zfirst], &src[zlast], &dst[zfirst]);
+        }
+        break;
+    case ENT_SIDE:
+        #pragma omp parallel for schedule(static)
+        for (int sch = 0; sch < numsch; ++sch) {
+            int sfirst = schsfirst[sch];
+            int slast = schslast[sch];
+            copy(&src[sfirst], &src[slast], &dst[sfirst]);
+        }
+        break;
+    case ENT_EDGE:
+        #pragma omp parallel for schedule(static)
+        for (int sch = 0; sch < numsch; ++sch) {
+            for (int s = schsfirst[sch]; s < schslast[sch]; ++s) {
+                int e = mapse[s];
+                if (echfirst[e] == sch) dst[e] = src[e];
+            }
+        }
+        break;
+    }
+
+}
+
+
+void Mesh::writePlacement() {
+
+    if (Parallel::mype > 0) return;
+
+    vector<int> thrnode;
+    Numa::getThreadNodes(thrnode);
+
+    // thread that runs each chunk in Hydro::doCycle
+    vector<int> schthr(numsch, 0), pchthr(numpch, 0);
+    #pragma omp parallel for schedule(static)
+    for (int sch = 0; sch < numsch; ++sch) {
+#ifdef _OPENMP
+        schthr[sch] = omp_get_thread_num();
+#endif
+    }
+    #pragma omp parallel for schedule(static)
+    for (int pch = 0; pch < numpch; ++pch) {
+#ifdef _OPENMP
+        pchthr[pch] = omp_get_thread_num();
+#endif
+    }
+
+    // thread that uses each element of each entity
+    vector<int> thr[ENT_PCORNER + 1];
+    thr[ENT_POINT].resize(nump);
+    thr[ENT_PCORNER].resize(numc);
+    for (int pch = 0; pch < numpch; ++pch) {
+        fill(&thr[ENT_POINT][0] + pchpfirst[pch],
+                &thr[ENT_POINT][0] + pchplast[pch], pchthr[pch]);
+        fill(&thr[ENT_PCORNER][0] + mappcoff[pchpfirst[pch]],
+                &thr[ENT_PCORNER][0] + mappcoff[pchplast[pch]],
+                pchthr[pch]);
+    }
+    thr[ENT_ZONE].resize(numz);
+    thr[ENT_SIDE].resize(nums);
+    for (int sch = 0; sch < numsch; ++sch) {
+        fill(&thr[ENT_ZONE][0] + schzfirst[sch],
+                &thr[ENT_ZONE][0] + schzlast[sch], schthr[sch]);
+        fill(&thr[ENT_SIDE][0] + schsfirst[sch],
+                &thr[ENT_SIDE][0] + schslast[sch], schthr[sch]);
+    }
+    thr[ENT_EDGE].resize(nume);
+    for (int e = 0; e < nume; ++e)
+        thr[ENT_EDGE][e] = schthr[echfirst[e]];
+
+    cout << endl;
+    cout << "--- NUMA Page Placement (PE 0) ---" << endl;
+    cout << "Threads pinned:  " << (numapin ? "yes" : "no") << endl;
+    cout << "Thread nodes:  ";
+    for (int t = 0; t < thrnode.size(); ++t)
+        cout << " " << thrnode[t];
+    cout << endl;
+
+    const size_t psize = Numa::pageSize();
+    vector<int> pnode;
+    bool header = false;
+    for (int i = 0; i < placed.size(); ++i) {
+        const Placed& pl = placed[i];
+        const size_t compbytes = (size_t) pl.count * pl.elembytes;
+        const size_t bytes = compbytes * pl.numcomp;
+        if (!Numa::getPageNodes(pl.ptr, bytes, pnode)) {
+            cout << "Page placement not available on this system"
+                 << endl;
+            break;
+        }
+        if (!header) {
+            cout << "array        pages   local  untouched  pages by node"
+                 << endl;
+            header = true;
         }
-        mapccnext[c] = -1;
-        if (i+1 != numc) {
-            int pp = pcpair[i+1].first;
-            int cp = pcpair[i+1].second;
-            if (p == pp) mapccnext[c] = cp;
+
+        // a page belongs to the thread using the element at its
+        // start (or at the start of the array, for the first page)
+        const vector<int>& ethr = thr[pl.ent];
+        const uintptr_t pfirst = (uintptr_t) pl.ptr / psize * psize;
+        int numlocal = 0, numnone = 0;
+        vector<int> nodecount;
+        for (int k = 0; k < pnode.size(); ++k) {
+            if (pnode[k] < 0) {
+                ++numnone;
+                continue;
+            }
+            if (pnode[k] >= nodecount.size())
+                nodecount.resize(pnode[k] + 1, 0);
+            nodecount[pnode[k]] += 1;
+            size_t off = max(pfirst + k * psize, (uintptr_t) pl.ptr) -
+                    (uintptr_t) pl.ptr;
+            if (pl.count == 0 || off >= bytes) continue;
+            int elem = min((int) (off % compbytes / pl.elembytes),
+                    pl.count - 1);
+            if (pnode[k] == thrnode[ethr[elem]]) ++numlocal;
         }
+        const int numtouched = pnode.size() - numnone;
+        cout << left << setw(10) << pl.name << right
+             << setw(8) << pnode.size()
+             << setw(7) << fixed << setprecision(1)
+             << (numtouched > 0 ? 100. * numlocal / numtouched : 0.)
+             << "%" << setw(11) << numnone << " ";
+        for (int nd = 0; nd < nodecount.size(); ++nd)
+            cout << "  " << nd << ":" << nodecount[nd];
+        cout << endl;
     }
+    cout << "------------------------" << endl;
+
 }
 
 
@@ -300,33 +1084,33 @@ void Mesh::initParallel(
     if (Parallel::numpe == 1) return;
 
     nummstrpe = slavemstrpes.size();
-    mapmstrpepe = Memory::alloc<int>(nummstrpe);
+    mapmstrpepe = Memory::alloc<int>(nummstrpe, "mapmstrpepe");
     copy(slavemstrpes.begin(), slavemstrpes.end(), mapmstrpepe);
-    mstrpenumslv = Memory::alloc<int>(nummstrpe);
+    mstrpenumslv = Memory::alloc<int>(nummstrpe, "mstrpenumslv");
     copy(slavemstrcounts.begin(), slavemstrcounts.end(), mstrpenumslv);
-    mapmstrpeslv1 = Memory::alloc<int>(nummstrpe);
+    mapmstrpeslv1 = Memory::alloc<int>(nummstrpe, "mapmstrpeslv1");
     int count = 0;
     for (int mstrpe = 0; mstrpe < nummstrpe; ++mstrpe) {
         mapmstrpeslv1[mstrpe] = count;
         count += mstrpenumslv[mstrpe];
     }
     numslv = slavepoints.size();
-    mapslvp = Memory::alloc<int>(numslv);
+    mapslvp = Memory::alloc<int>(numslv, "mapslvp");
     copy(slavepoints.begin(), slavepoints.end(), mapslvp);
 
     numslvpe = masterslvpes.size();
-    mapslvpepe = Memory::alloc<int>(numslvpe);
+    mapslvpepe = Memory::alloc<int>(numslvpe, "mapslvpepe");
     copy(masterslvpes.begin(), masterslvpes.end(), mapslvpepe);
-    slvpenumprx = Memory::alloc<int>(numslvpe);
+    slvpenumprx = Memory::alloc<int>(numslvpe, "slvpenumprx");
     copy(masterslvcounts.begin(), masterslvcounts.end(), slvpenumprx);
-    mapslvpeprx1 = Memory::alloc<int>(numslvpe);
+    mapslvpeprx1 = Memory::alloc<int>(numslvpe, "mapslvpeprx1");
     count = 0;
     for (int slvpe = 0; slvpe < numslvpe; ++slvpe) {
         mapslvpeprx1[slvpe] = count;
         count += slvpenumprx[slvpe];
     }
     numprx = masterpoints.size();
-    mapprxp = Memory::alloc<int>(numprx);
+    mapprxp = Memory::alloc<int>(numprx, "mapprxp");
     copy(masterpoints.begin(), masterpoints.end(), mapprxp);
 
 }
@@ -338,12 +1122,16 @@ void Mesh::writeStats() {
     // make sure that boundary points aren't double-counted;
     // only count them if they are masters
     if (Parallel::numpe > 1) gnump -= numslv;
-    int64_t gnumz = numz;
+    gnumz = numz;
     int64_t gnums = nums;
     int64_t gnume = nume;
     int gnumpch = numpch;
     int gnumzch = numzch;
     int gnumsch = numsch;
+    int gnumpeq = (uniformsides && zonesides == 4);
+    int gnumper = (rectnzx > 0);
+    int gnumpes = (gnumpeq && rectnzx > 0 && structured);
+    int gnumpin = numapin;
 
     Parallel::globalSum(gnump);
     Parallel::globalSum(gnumz);
@@ -352,8 +1140,25 @@ void Mesh::writeStats() {
     Parallel::globalSum(gnumpch);
     Parallel::globalSum(gnumzch);
     Parallel::globalSum(gnumsch);
-
-    if (Parallel::mype > 0) return;
+    Parallel::globalSum(gnumpeq);
+    Parallel::globalSum(gnumper);
+    Parallel::globalSum(gnumpes);
+    Parallel::globalSum(gnumpin);
+
+    // memory in mesh maps (the only arrays allocated so far), and
+    // peak RSS so far, in MB
+    vector<Memory::Usage> fields;
+    Memory::Usage total;
+    Memory::getUsage(fields, total);
+    double gbytes = total.bytes;
+    double rss = Memory::getPeakRSS() * 1.e-6;
+    double rssmin = rss, rssmax = rss;
+    Parallel::globalSum(gbytes);
+    Parallel::globalSum(rss);
+    Parallel::globalMin(rssmin);
+    Parallel::globalMax(rssmax);
+
+    if (Parallel::mype > 0 || quiet) return;
 
     cout << "--- Mesh Information ---" << endl;
     cout << "Points:  " << gnump << endl;
@@ -364,6 +1169,22 @@ void Mesh::writeStats() {
     cout << "Point chunks:  " << gnumpch << endl;
     cout << "Zone chunks:  " << gnumzch << endl;
     cout << "Chunk size:  " << chunksize << endl;
+    cout << "Quad side loops:  " << gnumpeq << " of "
+         << Parallel::numpe << " PEs" << endl;
+    cout << "Rect grid point sums:  " << gnumper << " of "
+         << Parallel::numpe << " PEs" << endl;
+    cout << "Rect grid side loops:  " << gnumpes << " of "
+         << Parallel::numpe << " PEs" << endl;
+    cout << "Pinned threads:  " << gnumpin << " of "
+         << Parallel::numpe << " PEs" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Map memory (MB):  " << gbytes * 1.e-6 << " ("
+         << gbytes / max(gnumz, (int64_t) 1) << " bytes/zone)" << endl;
+    cout << "Peak RSS so far (MB):  " << rssmin << " min, "
+         << rss / Parallel::numpe << " avg, " << rssmax
+         << " max/PE" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
     cout << "------------------------" << endl;
 
 }
@@ -378,12 +1199,12 @@ void Mesh::write(
         const double* zp) {
 
     if (writexy) {
-        if (Parallel::mype == 0)
+        if (Parallel::mype == 0 && !quiet)
             cout << "Writing .xy file..." << endl;
         wxy->write(probname, zr, ze, zp);
     }
     if (writegold) {
-        if (Parallel::mype == 0) 
+        if (Parallel::mype == 0 && !quiet)
             cout << "Writing gold file..." << endl;
         egold->write(probname, cycle, time, zr, ze, zp);
     }
@@ -445,35 +1266,53 @@ void Mesh::getPlaneChunks(
 
 
 void Mesh::calcCtrs(
-        const double2* px,
-        double2* ex,
-        double2* zx,
+        const_double2ptr px,
+        double2ptr ex,
+        double2ptr zx,
         const int sfirst,
         const int slast) {
 
-    int zfirst = mapsz[sfirst];
-    int zlast = (slast < nums ? mapsz[slast] : numz);
-    fill(&zx[zfirst], &zx[zlast], double2(0., 0.));
+    const CalcCtrsOp op = { this, px, ex, zx, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcCtrs(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::ptr2 ex,
+        typename FT::ptr2 zx,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real2 real2;
+
+    int zfirst = sm.zone(sfirst);
+    int zlast = (slast < nums ? sm.zone(slast) : numz);
+    for (int z = zfirst; z < zlast; ++z)
+        zx[z] = real2(0., 0.);
 
     for (int s = sfirst; s < slast; ++s) {
-        int p1 = mapsp1[s];
-        int p2 = mapsp2[s];
-        int e = mapse[s];
-        int z = mapsz[s];
+        int p1 = sm.p1(s);
+        int p2 = sm.p2(s);
+        int e = sm.edge(s);
+        int z = sm.zone(s);
         ex[e] = 0.5 * (px[p1] + px[p2]);
         zx[z] += px[p1];
     }
 
     for (int z = zfirst; z < zlast; ++z) {
-        zx[z] /= (double) znump[z];
+        zx[z] /= (double) sm.size(z);
     }
 
 }
 
 
 void Mesh::calcVols(
-        const double2* px,
-        const double2* zx,
+        const_double2ptr px,
+        const_double2ptr zx,
         double* sarea,
         double* svol,
         double* zarea,
@@ -481,28 +1320,49 @@ void Mesh::calcVols(
         const int sfirst,
         const int slast) {
 
-    int zfirst = mapsz[sfirst];
-    int zlast = (slast < nums ? mapsz[slast] : numz);
-    fill(&zvol[zfirst], &zvol[zlast], 0.);
-    fill(&zarea[zfirst], &zarea[zlast], 0.);
+    const CalcVolsOp op = { this, px, zx, sarea, svol, zarea, zvol, sfirst,
+            slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcVols(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::cptr2 zx,
+        typename FT::ptr sarea,
+        typename FT::ptr svol,
+        typename FT::ptr zarea,
+        typename FT::ptr zvol,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+
+    int zfirst = sm.zone(sfirst);
+    int zlast = (slast < nums ? sm.zone(slast) : numz);
+    fill(&zvol[zfirst], &zvol[zlast], real(0.));
+    fill(&zarea[zfirst], &zarea[zlast], real(0.));
 
     const double third = 1. / 3.;
     int count = 0;
     for (int s = sfirst; s < slast; ++s) {
-        int p1 = mapsp1[s];
-        int p2 = mapsp2[s];
-        int z = mapsz[s];
+        int p1 = sm.p1(s);
+        int p2 = sm.p2(s);
+        int z = sm.zone(s);
 
         // compute side volumes, sum to zone
-        double sa = 0.5 * cross(px[p2] - px[p1], zx[z] - px[p1]);
-        double sv = third * sa * (px[p1].x + px[p2].x + zx[z].x);
+        real sa = 0.5 * cross(px[p2] - px[p1], zx[z] - px[p1]);
+        real sv = third * sa * (px[p1].x + px[p2].x + zx[z].x);
         sarea[s] = sa;
         svol[s] = sv;
         zarea[z] += sa;
         zvol[z] += sv;
 
         // check for negative side volumes
-        if (sv <= 0.) count += 1;
+        count += countTrue(sv <= 0.);
 
     } // for s
 
@@ -533,25 +1393,55 @@ void Mesh::calcSideFracs(
         const int sfirst,
         const int slast) {
 
+    const CalcSideFracsOp op = { this, sarea, zarea, smf, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcSideFracs(
+        const SM sm,
+        typename FT::cptr sarea,
+        typename FT::cptr zarea,
+        typename FT::ptr smf,
+        const int sfirst,
+        const int slast) {
+
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int z = mapsz[s];
+        int z = sm.zone(s);
         smf[s] = sarea[s] / zarea[z];
     }
 }
 
 
 void Mesh::calcSurfVecs(
-        const double2* zx,
-        const double2* ex,
-        double2* ssurf,
+        const_double2ptr zx,
+        const_double2ptr ex,
+        double2ptr ssurf,
+        const int sfirst,
+        const int slast) {
+
+    const CalcSurfVecsOp op = { this, zx, ex, ssurf, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcSurfVecs(
+        const SM sm,
+        typename FT::cptr2 zx,
+        typename FT::cptr2 ex,
+        typename FT::ptr2 ssurf,
         const int sfirst,
         const int slast) {
 
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int z = mapsz[s];
-        int e = mapse[s];
+        int z = sm.zone(s);
+        int e = sm.edge(s);
 
         ssurf[s] = rotateCCW(ex[e] - zx[z]);
 
@@ -561,15 +1451,29 @@ void Mesh::calcSurfVecs(
 
 
 void Mesh::calcEdgeLen(
-        const double2* px,
+        const_double2ptr px,
         double* elen,
         const int sfirst,
         const int slast) {
 
+    const CalcEdgeLenOp op = { this, px, elen, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcEdgeLen(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::ptr elen,
+        const int sfirst,
+        const int slast) {
+
     for (int s = sfirst; s < slast; ++s) {
-        const int p1 = mapsp1[s];
-        const int p2 = mapsp2[s];
-        const int e = mapse[s];
+        const int p1 = sm.p1(s);
+        const int p2 = sm.p2(s);
+        const int e = sm.edge(s);
 
         elen[e] = length(px[p2] - px[p1]);
 
@@ -583,23 +1487,289 @@ void Mesh::calcCharLen(
         const int sfirst,
         const int slast) {
 
-    int zfirst = mapsz[sfirst];
-    int zlast = (slast < nums ? mapsz[slast] : numz);
-    fill(&zdl[zfirst], &zdl[zlast], 1.e99);
+    const CalcCharLenOp op = { this, sarea, elen, zdl, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcCharLen(
+        const SM sm,
+        typename FT::cptr sarea,
+        typename FT::cptr elen,
+        typename FT::ptr zdl,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+
+    int zfirst = sm.zone(sfirst);
+    int zlast = (slast < nums ? sm.zone(slast) : numz);
+    fill(&zdl[zfirst], &zdl[zlast], real(1.e99));
 
     for (int s = sfirst; s < slast; ++s) {
-        int z = mapsz[s];
-        int e = mapse[s];
+        int z = sm.zone(s);
+        int e = sm.edge(s);
 
-        double area = sarea[s];
-        double base = elen[e];
-        double fac = (znump[z] == 3 ? 3. : 4.);
-        double sdl = fac * area / base;
+        real area = sarea[s];
+        real base = elen[e];
+        double fac = (sm.size(z) == 3 ? 3. : 4.);
+        real sdl = fac * area / base;
         zdl[z] = min(zdl[z], sdl);
     }
 }
 
 
+void Mesh::calcGeomFused(
+        const_double2ptr px,
+        double2ptr ex,
+        double2ptr zx,
+        double* sarea,
+        double* svol,
+        double* zarea,
+        double* zvol,
+        double2ptr ssurf,
+        double* elen,
+        double* zdl,
+        const int sfirst,
+        const int slast) {
+
+    const CalcGeomFusedOp op = { this, px, ex, zx, sarea, svol, zarea, zvol,
+            ssurf, elen, zdl, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcGeomFused(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::ptr2 ex,
+        typename FT::ptr2 zx,
+        typename FT::ptr sarea,
+        typename FT::ptr svol,
+        typename FT::ptr zarea,
+        typename FT::ptr zvol,
+        typename FT::ptr2 ssurf,
+        typename FT::ptr elen,
+        typename FT::ptr zdl,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    // the sides of a zone are contiguous, so each zone's maps
+    // and points are read from memory once; the second loop over
+    // a zone's sides finds them in cache
+    const double third = 1. / 3.;
+    int count = 0;
+    for (int sz = sfirst; sz < slast; sz += sm.size(sm.zone(sz))) {
+        const int z = sm.zone(sz);
+        const int szlast = sz + sm.size(z);
+
+        // edge and zone centers
+        real2 zxz(0., 0.);
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            int e = sm.edge(s);
+            ex[e] = 0.5 * (px[p1] + px[p2]);
+            zxz += px[p1];
+        }
+        zxz /= (double) sm.size(z);
+        zx[z] = zxz;
+
+        // side volumes, summed to zone; surface vectors;
+        // edge and characteristic lengths
+        const double fac = (sm.size(z) == 3 ? 3. : 4.);
+        real za = 0.;
+        real zv = 0.;
+        real dl = 1.e99;
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            int e = sm.edge(s);
+
+            real sa = 0.5 * cross(px[p2] - px[p1], zxz - px[p1]);
+            real sv = third * sa * (px[p1].x + px[p2].x + zxz.x);
+            sarea[s] = sa;
+            svol[s] = sv;
+            za += sa;
+            zv += sv;
+            count += countTrue(sv <= 0.);
+
+            ssurf[s] = rotateCCW(ex[e] - zxz);
+            real el = length(px[p2] - px[p1]);
+            elen[e] = el;
+            real sdl = fac * sa / el;
+            dl = min(dl, sdl);
+        }
+        zarea[z] = za;
+        zvol[z] = zv;
+        zdl[z] = dl;
+    }  // for sz
+
+    if (count > 0) {
+        #pragma omp atomic
+        numsbad += count;
+    }
+
+}
+
+
+void Mesh::calcGeomLean(
+        const_double2ptr px,
+        double2ptr ex,
+        double2ptr zx,
+        double* zarea,
+        double* zvol,
+        double* elen,
+        double* zdl,
+        const int sfirst,
+        const int slast) {
+
+    const CalcGeomLeanOp op = { this, px, ex, zx, zarea, zvol, elen, zdl,
+            sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcGeomLean(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::ptr2 ex,
+        typename FT::ptr2 zx,
+        typename FT::ptr zarea,
+        typename FT::ptr zvol,
+        typename FT::ptr elen,
+        typename FT::ptr zdl,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    // as calcGeomFused, without storing side areas, volumes and
+    // surface vectors
+    const double third = 1. / 3.;
+    int count = 0;
+    for (int sz = sfirst; sz < slast; sz += sm.size(sm.zone(sz))) {
+        const int z = sm.zone(sz);
+        const int szlast = sz + sm.size(z);
+
+        real2 zxz(0., 0.);
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            int e = sm.edge(s);
+            ex[e] = 0.5 * (px[p1] + px[p2]);
+            zxz += px[p1];
+        }
+        zxz /= (double) sm.size(z);
+        zx[z] = zxz;
+
+        const double fac = (sm.size(z) == 3 ? 3. : 4.);
+        real za = 0.;
+        real zv = 0.;
+        real dl = 1.e99;
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            int e = sm.edge(s);
+
+            real sa = 0.5 * cross(px[p2] - px[p1], zxz - px[p1]);
+            real sv = third * sa * (px[p1].x + px[p2].x + zxz.x);
+            za += sa;
+            zv += sv;
+            count += countTrue(sv <= 0.);
+
+            real el = length(px[p2] - px[p1]);
+            elen[e] = el;
+            real sdl = fac * sa / el;
+            dl = min(dl, sdl);
+        }
+        zarea[z] = za;
+        zvol[z] = zv;
+        zdl[z] = dl;
+    }  // for sz
+
+    if (count > 0) {
+        #pragma omp atomic
+        numsbad += count;
+    }
+
+}
+
+
+void Mesh::calcZoneGeom(
+        const_double2ptr px,
+        double2ptr zx,
+        double* zarea,
+        double* zvol,
+        const int sfirst,
+        const int slast) {
+
+    const CalcZoneGeomOp op = { this, px, zx, zarea, zvol, sfirst, slast };
+    dispatchSideMap(this, op);
+
+}
+
+
+template <typename FT, typename SM>
+void Mesh::calcZoneGeom(
+        const SM sm,
+        typename FT::cptr2 px,
+        typename FT::ptr2 zx,
+        typename FT::ptr zarea,
+        typename FT::ptr zvol,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    // zone centers, areas and volumes, as from calcCtrs and
+    // calcVols, without storing edge centers or side geometry
+    const double third = 1. / 3.;
+    int count = 0;
+    for (int sz = sfirst; sz < slast; sz += sm.size(sm.zone(sz))) {
+        const int z = sm.zone(sz);
+        const int szlast = sz + sm.size(z);
+
+        real2 zxz(0., 0.);
+        for (int s = sz; s < szlast; ++s)
+            zxz += px[sm.p1(s)];
+        zxz /= (double) sm.size(z);
+        zx[z] = zxz;
+
+        real za = 0.;
+        real zv = 0.;
+        for (int s = sz; s < szlast; ++s) {
+            int p1 = sm.p1(s);
+            int p2 = sm.p2(s);
+            real sa = 0.5 * cross(px[p2] - px[p1], zxz - px[p1]);
+            real sv = third * sa * (px[p1].x + px[p2].x + zxz.x);
+            za += sa;
+            zv += sv;
+            count += countTrue(sv <= 0.);
+        }
+        zarea[z] = za;
+        zvol[z] = zv;
+    }  // for sz
+
+    if (count > 0) {
+        #pragma omp atomic
+        numsbad += count;
+    }
+
+}
+
+
 template <typename T>
 void Mesh::parallelGather(
         const T* pvar,
@@ -609,12 +1779,13 @@ void Mesh::parallelGather(
     const int tagmpi = 100;
     const int type_size = sizeof(T);
 //    std::vector<T> slvvar(numslv);
-    T* slvvar = Memory::alloc<T>(numslv);
+    Memory::ScratchScope scope;
+    T* slvvar = Memory::scratch<T>(numslv);
 
     // Post receives for incoming messages from slaves.
     // Store results in proxy buffer.
 //    vector<MPI_Request> request(numslvpe);
-    MPI_Request* request = Memory::alloc<MPI_Request>(numslvpe);
+    MPI_Request* request = Memory::scratch<MPI_Request>(numslvpe);
     for (int slvpe = 0; slvpe < numslvpe; ++slvpe) {
         int pe = mapslvpepe[slvpe];
         int nprx = slvpenumprx[slvpe];
@@ -640,7 +1811,7 @@ void Mesh::parallelGather(
 
     // Wait for all receives to complete.
 //    vector<MPI_Status> status(numslvpe);
-    MPI_Status* status = Memory::alloc<MPI_Status>(numslvpe);
+    MPI_Status* status = Memory::scratch<MPI_Status>(numslvpe);
     int ierr = MPI_Waitall(numslvpe, &request[0], &status[0]);
     if (ierr != 0) {
         cerr << "Error: parallelGather MPI error " << ierr <<
@@ -648,10 +1819,6 @@ void Mesh::parallelGather(
         cerr << "Exiting..." << endl;
         exit(1);
     }
-
-    Memory::free(slvvar);
-    Memory::free(request);
-    Memory::free(status);
 #endif
 }
 
@@ -687,12 +1854,13 @@ void Mesh::parallelScatter(
     const int tagmpi = 200;
     const int type_size = sizeof(T);
 //    std::vector<T> slvvar(numslv);
-    T* slvvar = Memory::alloc<T>(numslv);
+    Memory::ScratchScope scope;
+    T* slvvar = Memory::scratch<T>(numslv);
 
     // Post receives for incoming messages from masters.
     // Store results in slave buffer.
 //    vector<MPI_Request> request(nummstrpe);
-    MPI_Request* request = Memory::alloc<MPI_Request>(nummstrpe);
+    MPI_Request* request = Memory::scratch<MPI_Request>(nummstrpe);
     for (int mstrpe = 0; mstrpe < nummstrpe; ++mstrpe) {
         int pe = mapmstrpepe[mstrpe];
         int nslv = mstrpenumslv[mstrpe];
@@ -712,7 +1880,7 @@ void Mesh::parallelScatter(
 
     // Wait for all receives to complete.
 //    vector<MPI_Status> status(nummstrpe);
-    MPI_Status* status = Memory::alloc<MPI_Status>(nummstrpe);
+    MPI_Status* status = Memory::scratch<MPI_Status>(nummstrpe);
     int ierr = MPI_Waitall(nummstrpe, &request[0], &status[0]);
     if (ierr != 0) {
         cerr << "Error: parallelScatter MPI error " << ierr <<
@@ -726,10 +1894,6 @@ void Mesh::parallelScatter(
         int p = mapslvp[slv];
         pvar[p] = slvvar[slv];
     }
-
-    Memory::free(slvvar);
-    Memory::free(request);
-    Memory::free(status);
 #endif
 }
 
@@ -738,11 +1902,11 @@ template <typename T>
 void Mesh::sumAcrossProcs(T* pvar) {
     if (Parallel::numpe == 1) return;
 //    std::vector<T> prxvar(numprx);
-    T* prxvar = Memory::alloc<T>(numprx);
+    Memory::ScratchScope scope;
+    T* prxvar = Memory::scratch<T>(numprx);
     parallelGather(pvar, &prxvar[0]);
     parallelSum(pvar, &prxvar[0]);
     parallelScatter(pvar, &prxvar[0]);
-    Memory::free(prxvar);
 }
 
 
@@ -755,38 +1919,159 @@ void Mesh::sumOnProc(
     for (int pch = 0; pch < numpch; ++pch) {
         int pfirst = pchpfirst[pch];
         int plast = pchplast[pch];
+        double t0 = timer->start();
+        if (rectnzx > 0) {
+            sumOnProcRect(cvar, pvar, pfirst, plast);
+            timer->lap(Timer::PH_SUMONPROC, t0);
+            continue;
+        }
         for (int p = pfirst; p < plast; ++p) {
             T x = T();
-            for (int c = mappcfirst[p]; c >= 0; c = mapccnext[c]) {
-                x += cvar[c];
+            for (int i = mappcoff[p]; i < mappcoff[p+1]; ++i) {
+                x += cvar[mappc[i]];
             }
             pvar[p] = x;
         }  // for p
+        timer->lap(Timer::PH_SUMONPROC, t0);
     }  // for pch
 
 }
 
 
-template <>
+template <typename T>
+void Mesh::sumOnProcRect(
+        const T* cvar,
+        T* pvar,
+        const int pfirst,
+        const int plast) {
+
+    // the corners of point (i, j), in the ascending order used by
+    // mappc:  corner 2 of zone (i-1, j-1), 3 of (i, j-1), 1 of
+    // (i-1, j), 0 of (i, j)
+    const int nzx = rectnzx;
+    const int nzy = rectnzy;
+    const int npx = nzx + 1;
+    int j = pfirst / npx;
+    int i = pfirst - j * npx;
+    for (int p = pfirst; p < plast; ++p) {
+        const int z = j * nzx + i;
+        T x = T();
+        if (j > 0) {
+            if (i > 0) x += cvar[4 * (z - nzx - 1) + 2];
+            if (i < nzx) x += cvar[4 * (z - nzx) + 3];
+        }
+        if (j < nzy) {
+            if (i > 0) x += cvar[4 * (z - 1) + 1];
+            if (i < nzx) x += cvar[4 * z];
+        }
+        pvar[p] = x;
+        if (++i == npx) {
+            i = 0;
+            ++j;
+        }
+    }  // for p
+
+}
+
+
+template <typename T>
 void Mesh::sumToPoints(
-        const double* cvar,
-        double* pvar) {
+        const T* cvar,
+        T* pvar) {
 
     sumOnProc(cvar, pvar);
-    if (Parallel::numpe > 1)
+    if (Parallel::numpe > 1) {
+        double t0 = timer->start();
         sumAcrossProcs(pvar);
+        timer->lap(Timer::PH_SUMACROSS, t0);
+    }
+
+}
+
+
+template void Mesh::sumToPoints(const double*, double*);
+#ifndef USE_SOA
+template void Mesh::sumToPoints(const double2*, double2*);
+
+#else  // USE_SOA
+
+void Mesh::sumOnProc(
+        const_double2ptr cvar,
+        double2ptr pvar) {
+
+    // sum both components in one pass, each as a stream of doubles
+    const double* cx = cvar.x;
+    const double* cy = cvar.y;
+    double* px = pvar.x;
+    double* py = pvar.y;
+    #pragma omp parallel for schedule(static)
+    for (int pch = 0; pch < numpch; ++pch) {
+        int pfirst = pchpfirst[pch];
+        int plast = pchplast[pch];
+        double t0 = timer->start();
+        if (rectnzx > 0) {
+            sumOnProcRect(cx, px, pfirst, plast);
+            sumOnProcRect(cy, py, pfirst, plast);
+            timer->lap(Timer::PH_SUMONPROC, t0);
+            continue;
+        }
+        for (int p = pfirst; p < plast; ++p) {
+            double x = 0., y = 0.;
+            for (int i = mappcoff[p]; i < mappcoff[p+1]; ++i) {
+                x += cx[mappc[i]];
+                y += cy[mappc[i]];
+            }
+            px[p] = x;
+            py[p] = y;
+        }  // for p
+        timer->lap(Timer::PH_SUMONPROC, t0);
+    }  // for pch
 
 }
 
 
-template <>
 void Mesh::sumToPoints(
-        const double2* cvar,
-        double2* pvar) {
+        const_double2ptr cvar,
+        double2ptr pvar) {
 
     sumOnProc(cvar, pvar);
-    if (Parallel::numpe > 1)
-        sumAcrossProcs(pvar);
+    if (Parallel::numpe > 1) {
+        double t0 = timer->start();
+        sumAcrossProcs(pvar.x);
+        sumAcrossProcs(pvar.y);
+        timer->lap(Timer::PH_SUMACROSS, t0);
+    }
 
 }
-
+#endif  // USE_SOA
+
+
+
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES(FT) \
+    template void Mesh::sumToPoints(const FT::real*, FT::real*); \
+    template void Mesh::sumToPoints(const FT::real2*, FT::real2*);
+FOR_EACH_LANES(INSTANTIATE_LANES)
+#undef INSTANTIATE_LANES
+
+#define INSTANTIATE_LANES_SM(FT, SM) \
+    template void Mesh::calcCtrs<FT, SM>(const SM, FT::cptr2, FT::ptr2, \
+            FT::ptr2, const int, const int); \
+    template void Mesh::calcVols<FT, SM>(const SM, FT::cptr2, FT::cptr2, \
+            FT::ptr, FT::ptr, FT::ptr, FT::ptr, const int, const int); \
+    template void Mesh::calcSurfVecs<FT, SM>(const SM, FT::cptr2, \
+            FT::cptr2, FT::ptr2, const int, const int); \
+    template void Mesh::calcEdgeLen<FT, SM>(const SM, FT::cptr2, FT::ptr, \
+            const int, const int); \
+    template void Mesh::calcCharLen<FT, SM>(const SM, FT::cptr, FT::cptr, \
+            FT::ptr, const int, const int); \
+    template void Mesh::calcGeomFused<FT, SM>(const SM, FT::cptr2, \
+            FT::ptr2, FT::ptr2, FT::ptr, FT::ptr, FT::ptr, FT::ptr, \
+            FT::ptr2, FT::ptr, FT::ptr, const int, const int); \
+    template void Mesh::calcGeomLean<FT, SM>(const SM, FT::cptr2, \
+            FT::ptr2, FT::ptr2, FT::ptr, FT::ptr, FT::ptr, FT::ptr, \
+            const int, const int); \
+    template void Mesh::calcZoneGeom<FT, SM>(const SM, FT::cptr2, \
+            FT::ptr2, FT::ptr, FT::ptr, const int, const int);
+FOR_EACH_LANES_SM(INSTANTIATE_LANES_SM)
+#undef INSTANTIATE_LANES_SM
@@ -13,33 +13,64 @@
 #ifndef MESH_HH_
 #define MESH_HH_
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
 
 // forward declarations
 class InputFile;
 class GenMesh;
+class MeshOrder;
 class WriteXY;
 class ExportGold;
+class Timer;
+class ChkptWriter;
+class ChkptReader;
 
 
 class Mesh {
 public:
 
+    // associated timer object
+    Timer* timer;
+
     // children
     GenMesh* gmesh;
+    MeshOrder* morder;
     WriteXY* wxy;
     ExportGold* egold;
 
     // parameters
     int chunksize;                 // max size for processing chunks
+    bool chunkauto;                // flag:  choose chunksize at
+                                   // startup by timing candidates?
     std::vector<double> subregion; // bounding box for a subregion
                                    // if nonempty, should have 4 entries:
                                    // xmin, xmax, ymin, ymax
     bool writexy;                  // flag:  write .xy file?
     bool writegold;                // flag:  write Ensight file?
+    bool quiet;                    // flag:  suppress output?
+    bool fusedgeom;                // flag:  use calcGeomFused in
+                                   // hydro predictor?
+    bool uniformsides;             // flag:  use side loops
+                                   // specialized for zonesides?
+    bool structured;               // flag:  use side loops that
+                                   // compute points and edges on
+                                   // rect grids?  (needs
+                                   // uniformsides)
+    bool numaplace;                // flag:  place arrays on the
+                                   // NUMA nodes of the threads
+                                   // that use them?
+    bool numapin;                  // flag:  pin threads to CPUs?
+    bool numareport;               // flag:  report page placement?
+    bool leanmem;                  // flag:  recompute side geometry
+                                   // where it is used, instead of
+                                   // storing it?
+    double leanbytes;              // bytes not stored because of
+                                   // leanmem
 
     // mesh variables
     // (See documentation for more details on the mesh
@@ -48,6 +79,19 @@ public:
                        // number of points, edges, zones,
                        // sides, corners, resp.
     int numsbad;       // number of bad sides (negative volume)
+    int zonesides;     // number of sides in every zone, if all zones
+                       // have the same number and side s is in zone
+                       // s / zonesides; 0 otherwise.  Side loops
+                       // use it only if uniformsides is set
+    int rectnzx, rectnzy;
+                       // number of zones in x, y directions, if the
+                       // maps are those of a structured rect grid
+                       // (see SideMapRect); 0 otherwise.  Point sums
+                       // on such grids use a 4-corner stencil
+    int64_t gnumz;     // number of zones summed over all PEs
+    std::vector<int> zoneorig;
+                       // map: zone -> zone index as generated
+                       // (empty if zones have not been reordered)
     int* mapsp1;       // maps: side -> points 1 and 2
     int* mapsp2;
     int* mapsz;        // map: side -> zone
@@ -55,9 +99,11 @@ public:
     int* mapss3;       // map: side -> previous side
     int* mapss4;       // map: side -> next side
 
-    // point-to-corner inverse map is stored as a linked list...
-    int* mappcfirst;   // map:  point -> first corner
-    int* mapccnext;    // map:  corner -> next corner
+    // point-to-corner inverse map, in compressed sparse row form:
+    // the corners of point p are mappc[mappcoff[p]] through
+    // mappc[mappcoff[p+1]-1], in ascending order
+    int* mappcoff;     // map:  point -> offset of first corner
+    int* mappc;        // corners, grouped by point
 
     // mpi comm variables
     int nummstrpe;     // number of messages mype sends to master pes
@@ -75,25 +121,27 @@ public:
 
     int* znump;        // number of points in zone
 
-    double2* px;       // point coordinates
-    double2* ex;       // edge center coordinates
-    double2* zx;       // zone center coordinates
-    double2* pxp;      // point coords, middle of cycle
-    double2* exp;      // edge ctr coords, middle of cycle
-    double2* zxp;      // zone ctr coords, middle of cycle
-    double2* px0;      // point coords, start of cycle
+    double2ptr px;       // point coordinates
+    double2ptr ex;       // edge center coordinates (NULL if leanmem)
+    double2ptr zx;       // zone center coordinates
+    double2ptr pxp;      // point coords, middle of cycle
+    double2ptr exp;      // edge ctr coords, middle of cycle
+    double2ptr zxp;      // zone ctr coords, middle of cycle
+    double2ptr px0;      // point coords, start of cycle
 
-    double* sarea;     // side area
-    double* svol;      // side volume
+    double* sarea;     // side area (NULL if leanmem)
+    double* svol;      // side volume (NULL if leanmem)
     double* zarea;     // zone area
     double* zvol;      // zone volume
     double* sareap;    // side area, middle of cycle
+                       // (NULL if leanmem)
     double* svolp;     // side volume, middle of cycle
+                       // (NULL if leanmem)
     double* zareap;    // zone area, middle of cycle
     double* zvolp;     // zone volume, middle of cycle
     double* zvol0;     // zone volume, start of cycle
 
-    double2* ssurfp;   // side surface vector
+    double2ptr ssurfp;   // side surface vector (NULL if leanmem)
     double* elen;      // edge length
     double* smf;       // side mass fraction
     double* zdl;       // zone characteristic length
@@ -110,24 +158,114 @@ public:
     std::vector<int> zchzfirst;    // start/stop index for zone chunks
     std::vector<int> zchzlast;
 
-    Mesh(const InputFile* inp);
+    // entity that a placed array is indexed by (see placeArrays)
+    // (ENT_PCORNER:  corners grouped by point, as in mappc)
+    enum Entity { ENT_POINT, ENT_EDGE, ENT_ZONE, ENT_SIDE, ENT_PCORNER };
+
+    // an array recorded by place(), for writePlacement
+    struct Placed {
+        std::string name;
+        const char* ptr;           // start of array
+        int count;                 // number of elements
+        int elembytes;             // bytes per element
+        int numcomp;               // number of components stored
+                                   // one after another (2 for a
+                                   // double2 array in USE_SOA)
+        Entity ent;
+    };
+    std::vector<Placed> placed;
+    std::vector<int> echfirst;     // first side chunk to use each
+                                   // edge, for placing edge arrays
+
+    Mesh(const InputFile* inp, Timer* t, ChkptReader* cr);
     ~Mesh();
 
+    // set the process-wide memory policy from the memalign and
+    // hugepages keys
+    static void setMemPolicy(const InputFile* inp);
+
     void init();
 
+    // restore mesh from checkpoint, skipping mesh generation
+    // and map construction
+    void initFromChkpt(ChkptReader& cr);
+
+    // add mesh state to checkpoint
+    void writeChkpt(ChkptWriter& cw);
+
+    // allocate geometry arrays
+    void initGeom();
+
+    // free the geometry arrays that leanmem does not keep
+    void dropLeanArrays();
+
+    // add point positions and geometry that carry over from one
+    // cycle to the next to a snapshot
+    void writeState(ChkptWriter& cw);
+
+    // rebuild chunk information for a new chunksize
+    void setChunkSize(const int cs);
+
     // populate mapping arrays
     void initSides(
             const std::vector<int>& cellstart,
             const std::vector<int>& cellsize,
             const std::vector<int>& cellnodes);
     void initEdges();
+    // number edges of a rect grid by position instead
+    void initEdgesRect(const int nzx, const int nzy);
 
     // populate chunk information
     void initChunks();
 
+    // set zonesides, rectnzx and rectnzy from side maps
+    void initZoneSides();
+
     // populate inverse map
     void initInvMap();
 
+    // place mesh arrays:  if numaplace is set, move each map and
+    // geometry array to new memory, first touched in parallel with
+    // the same chunk-to-thread assignment that Hydro::doCycle uses,
+    // so that its pages are on the NUMA node of the thread that
+    // uses them; in any case, record the arrays for writePlacement
+    void placeArrays();
+
+    // place one array, indexed by entity ent, as in placeArrays;
+    // an array with extra elements past the last entity keeps
+    // them on the page of the last chunk
+    void place(
+            const std::string& name,
+            int*& var,
+            const Entity ent,
+            const int extra = 0);
+    void place(
+            const std::string& name,
+            double*& var,
+            const Entity ent);
+    void place(
+            const std::string& name,
+            double2ptr& var,
+            const Entity ent);
+    int entityCount(const Entity ent) const;
+    template <typename T>
+    void placeArray(
+            const std::string& name,
+            T*& var,
+            const Entity ent,
+            const int extra,
+            const int numcomp);
+    template <typename T>
+    void placeCopy(
+            const T* src,
+            T* dst,
+            const Entity ent);
+
+    // write, for each placed array, the fraction of its pages on
+    // the NUMA node of the thread that uses them, and the number
+    // of pages on each node (rank 0 only)
+    void writePlacement();
+
     void initParallel(
             const std::vector<int>& slavemstrpes,
             const std::vector<int>& slavemstrcounts,
@@ -159,24 +297,48 @@ public:
             std::vector<int>& pchbfirst,
             std::vector<int>& pchblast);
 
+    // each side loop below has a plain version, which calls the
+    // version templated on field types (see FieldTypes.hh) and a
+    // side map (see SideMap.hh) with FieldsOne and the best side
+    // map for this mesh
+
     // compute edge, zone centers
     void calcCtrs(
-            const double2* px,
-            double2* ex,
-            double2* zx,
+            const_double2ptr px,
+            double2ptr ex,
+            double2ptr zx,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    void calcCtrs(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::ptr2 ex,
+            typename FT::ptr2 zx,
             const int sfirst,
             const int slast);
 
     // compute side, corner, zone volumes
     void calcVols(
-            const double2* px,
-            const double2* zx,
+            const_double2ptr px,
+            const_double2ptr zx,
             double* sarea,
             double* svol,
             double* zarea,
             double* zvol,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    void calcVols(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::cptr2 zx,
+            typename FT::ptr sarea,
+            typename FT::ptr svol,
+            typename FT::ptr zarea,
+            typename FT::ptr zvol,
+            const int sfirst,
+            const int slast);
 
     // check to see if previous volume computation had any
     // sides with negative volumes
@@ -189,21 +351,44 @@ public:
             double* smf,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    void calcSideFracs(
+            const SM sm,
+            typename FT::cptr sarea,
+            typename FT::cptr zarea,
+            typename FT::ptr smf,
+            const int sfirst,
+            const int slast);
 
     // compute surface vectors for median mesh
     void calcSurfVecs(
-            const double2* zx,
-            const double2* ex,
-            double2* ssurf,
+            const_double2ptr zx,
+            const_double2ptr ex,
+            double2ptr ssurf,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    void calcSurfVecs(
+            const SM sm,
+            typename FT::cptr2 zx,
+            typename FT::cptr2 ex,
+            typename FT::ptr2 ssurf,
             const int sfirst,
             const int slast);
 
     // compute edge lengths
     void calcEdgeLen(
-            const double2* px,
+            const_double2ptr px,
             double* elen,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    void calcEdgeLen(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::ptr elen,
+            const int sfirst,
+            const int slast);
 
     // compute characteristic lengths
     void calcCharLen(
@@ -211,18 +396,122 @@ public:
             double* zdl,
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    void calcCharLen(
+            const SM sm,
+            typename FT::cptr sarea,
+            typename FT::cptr elen,
+            typename FT::ptr zdl,
+            const int sfirst,
+            const int slast);
+
+    // compute centers, side and zone areas and volumes, surface
+    // vectors, edge lengths and characteristic lengths together,
+    // one zone at a time; same results as calling calcCtrs,
+    // calcVols, calcSurfVecs, calcEdgeLen and calcCharLen
+    void calcGeomFused(
+            const_double2ptr px,
+            double2ptr ex,
+            double2ptr zx,
+            double* sarea,
+            double* svol,
+            double* zarea,
+            double* zvol,
+            double2ptr ssurf,
+            double* elen,
+            double* zdl,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    void calcGeomFused(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::ptr2 ex,
+            typename FT::ptr2 zx,
+            typename FT::ptr sarea,
+            typename FT::ptr svol,
+            typename FT::ptr zarea,
+            typename FT::ptr zvol,
+            typename FT::ptr2 ssurf,
+            typename FT::ptr elen,
+            typename FT::ptr zdl,
+            const int sfirst,
+            const int slast);
+
+    // geometry for the predictor in lean memory mode:  as
+    // calcGeomFused, without side areas, volumes and surface
+    // vectors
+    void calcGeomLean(
+            const_double2ptr px,
+            double2ptr ex,
+            double2ptr zx,
+            double* zarea,
+            double* zvol,
+            double* elen,
+            double* zdl,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    void calcGeomLean(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::ptr2 ex,
+            typename FT::ptr2 zx,
+            typename FT::ptr zarea,
+            typename FT::ptr zvol,
+            typename FT::ptr elen,
+            typename FT::ptr zdl,
+            const int sfirst,
+            const int slast);
+
+    // zone geometry only, for the corrector in lean memory mode
+    void calcZoneGeom(
+            const_double2ptr px,
+            double2ptr zx,
+            double* zarea,
+            double* zvol,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    void calcZoneGeom(
+            const SM sm,
+            typename FT::cptr2 px,
+            typename FT::ptr2 zx,
+            typename FT::ptr zarea,
+            typename FT::ptr zvol,
+            const int sfirst,
+            const int slast);
 
-    // sum corner variables to points (double or double2)
+    // sum corner variables to points (double, double2, or a
+    // lane type from VecW.hh)
     template <typename T>
     void sumToPoints(
             const T* cvar,
             T* pvar);
+#ifdef USE_SOA
+    void sumToPoints(
+            const_double2ptr cvar,
+            double2ptr pvar);
+#endif
 
     // helper routines for sumToPoints
     template <typename T>
     void sumOnProc(
             const T* cvar,
             T* pvar);
+#ifdef USE_SOA
+    void sumOnProc(
+            const_double2ptr cvar,
+            double2ptr pvar);
+#endif
+    // sumOnProc for a structured rect grid:  the corners of each
+    // point are found from its position in the grid
+    template <typename T>
+    void sumOnProcRect(
+            const T* cvar,
+            T* pvar,
+            const int pfirst,
+            const int plast);
     template <typename T>
     void sumAcrossProcs(T* pvar);
     template <typename T>
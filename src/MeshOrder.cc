@@ -0,0 +1,422 @@
+/*
+ * MeshOrder.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "MeshOrder.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <utility>
+
+#include "Vec2.hh"
+#include "Parallel.hh"
+#include "InputFile.hh"
+
+using namespace std;
+
+
+MeshOrder::MeshOrder(const InputFile* inp) {
+
+    using Parallel::mype;
+
+    order = inp->getString("meshorder", "none");
+    if (order != "none" &&
+            order != "hilbert" &&
+            order != "morton" &&
+            order != "rcm") {
+        if (mype == 0)
+            cerr << "Error:  meshorder = " << order
+                 << " is unknown" << endl;
+        exit(1);
+    }
+    quiet = inp->getInt("quiet", 0);
+
+}
+
+
+MeshOrder::~MeshOrder() {}
+
+
+void MeshOrder::reorder(
+        vector<double2>& pointpos,
+        vector<int>& zonestart,
+        vector<int>& zonesize,
+        vector<int>& zonepoints,
+        vector<int>& slavepoints,
+        vector<int>& masterpoints,
+        vector<int>& zoneorig) {
+
+    zoneorig.resize(0);
+    if (order == "none") return;
+
+    const int nump = pointpos.size();
+    const int numz = zonestart.size();
+    const int nums = zonepoints.size();
+
+    double spdist0, pcspan0, zzdist0;
+    calcLocality(nump, zonestart, zonesize, zonepoints,
+            spdist0, pcspan0, zzdist0);
+
+    vector<int> zorder;
+    if (order == "rcm") {
+        vector<int> adjstart, adj;
+        calcZoneAdj(zonestart, zonesize, zonepoints, adjstart, adj);
+        calcRCMOrder(adjstart, adj, zorder);
+    }
+    else
+        calcCurveOrder(pointpos, zonestart, zonesize, zonepoints, zorder);
+
+    // renumber zones, copying each zone's points in their
+    // original order; number points as they are first used
+    vector<int> newstart(numz), newsize(numz), newzp(nums);
+    vector<int> mapp(nump, -1);
+    vector<double2> newpos(nump);
+    int np = 0;
+    int s = 0;
+    for (int z = 0; z < numz; ++z) {
+        int zold = zorder[z];
+        int sfirst = zonestart[zold];
+        int size = zonesize[zold];
+        newstart[z] = s;
+        newsize[z] = size;
+        for (int i = 0; i < size; ++i) {
+            int p = zonepoints[sfirst + i];
+            if (mapp[p] < 0) {
+                mapp[p] = np;
+                newpos[np] = pointpos[p];
+                np += 1;
+            }
+            newzp[s] = mapp[p];
+            s += 1;
+        }
+    }
+    // any points not used by a zone go at the end
+    for (int p = 0; p < nump; ++p) {
+        if (mapp[p] >= 0) continue;
+        mapp[p] = np;
+        newpos[np] = pointpos[p];
+        np += 1;
+    }
+
+    pointpos.swap(newpos);
+    zonestart.swap(newstart);
+    zonesize.swap(newsize);
+    zonepoints.swap(newzp);
+    // slave and master lists keep their order, so they still
+    // match the lists on other PEs
+    for (int i = 0; i < slavepoints.size(); ++i)
+        slavepoints[i] = mapp[slavepoints[i]];
+    for (int i = 0; i < masterpoints.size(); ++i)
+        masterpoints[i] = mapp[masterpoints[i]];
+    zoneorig.swap(zorder);
+
+    double spdist1, pcspan1, zzdist1;
+    calcLocality(nump, zonestart, zonesize, zonepoints,
+            spdist1, pcspan1, zzdist1);
+
+    if (Parallel::mype > 0 || quiet) return;
+
+    cout << "--- Mesh Ordering ---" << endl;
+    cout << "Ordering:  " << order << endl;
+    cout << "Side-point distance:  " << spdist0
+         << " -> " << spdist1 << endl;
+    cout << "Point-corner span:  " << pcspan0
+         << " -> " << pcspan1 << endl;
+    cout << "Zone-zone distance:  " << zzdist0
+         << " -> " << zzdist1 << endl;
+    cout << "---------------------" << endl;
+
+}
+
+
+void MeshOrder::calcCurveOrder(
+        const vector<double2>& pointpos,
+        const vector<int>& zonestart,
+        const vector<int>& zonesize,
+        const vector<int>& zonepoints,
+        vector<int>& zorder) {
+
+    const int bits = 16;
+    const int numz = zonestart.size();
+
+    // find zone centers (as the average of their points), and
+    // the box containing them
+    vector<double2> zc(numz);
+    double2 cmin(1.e99, 1.e99), cmax(-1.e99, -1.e99);
+    for (int z = 0; z < numz; ++z) {
+        double2 c(0., 0.);
+        for (int i = 0; i < zonesize[z]; ++i)
+            c += pointpos[zonepoints[zonestart[z] + i]];
+        c /= (double) zonesize[z];
+        zc[z] = c;
+        cmin.x = min(cmin.x, c.x);
+        cmin.y = min(cmin.y, c.y);
+        cmax.x = max(cmax.x, c.x);
+        cmax.y = max(cmax.y, c.y);
+    }
+
+    // scale both directions by the same factor, so that the
+    // curve follows the shape of the mesh
+    const double ncell = (double) ((1 << bits) - 1);
+    const double len = max(max(cmax.x - cmin.x, cmax.y - cmin.y), 1.e-99);
+    const double scale = ncell / len;
+
+    vector<pair<uint64_t, int> > keyz(numz);
+    for (int z = 0; z < numz; ++z) {
+        uint32_t ix = (uint32_t) ((zc[z].x - cmin.x) * scale);
+        uint32_t iy = (uint32_t) ((zc[z].y - cmin.y) * scale);
+        uint64_t key = (order == "hilbert" ?
+                hilbertKey(bits, ix, iy) : mortonKey(bits, ix, iy));
+        keyz[z] = make_pair(key, z);
+    }
+    sort(keyz.begin(), keyz.end());
+
+    zorder.resize(numz);
+    for (int z = 0; z < numz; ++z)
+        zorder[z] = keyz[z].second;
+
+}
+
+
+void MeshOrder::calcRCMOrder(
+        const vector<int>& adjstart,
+        const vector<int>& adj,
+        vector<int>& zorder) {
+
+    const int numz = adjstart.size() - 1;
+
+    vector<int> level(numz, -1), lastlevel;
+    vector<char> visited(numz, 0);
+    vector<pair<int, int> > nbrs;
+    zorder.resize(0);
+    zorder.reserve(numz);
+
+    for (int z0 = 0; z0 < numz; ++z0) {
+        if (visited[z0]) continue;
+
+        // start from a zone at the edge of this connected piece
+        // of the mesh:  repeatedly move to the lowest-degree zone
+        // in the last level, while the number of levels grows
+        int root = z0;
+        int nlev = calcLevels(root, adjstart, adj, level, lastlevel);
+        while (true) {
+            int zmin = lastlevel[0];
+            for (int i = 1; i < lastlevel.size(); ++i) {
+                int z = lastlevel[i];
+                if (adjstart[z+1] - adjstart[z] <
+                        adjstart[zmin+1] - adjstart[zmin])
+                    zmin = z;
+            }
+            int nlevmin =
+                    calcLevels(zmin, adjstart, adj, level, lastlevel);
+            if (nlevmin <= nlev) break;
+            root = zmin;
+            nlev = nlevmin;
+        }
+
+        // Cuthill-McKee:  breadth-first, visiting the neighbors
+        // of each zone in order of increasing degree
+        int head = zorder.size();
+        zorder.push_back(root);
+        visited[root] = 1;
+        while (head < zorder.size()) {
+            int z = zorder[head];
+            head += 1;
+            nbrs.resize(0);
+            for (int i = adjstart[z]; i < adjstart[z+1]; ++i) {
+                int z2 = adj[i];
+                if (visited[z2]) continue;
+                visited[z2] = 1;
+                int deg = adjstart[z2+1] - adjstart[z2];
+                nbrs.push_back(make_pair(deg, z2));
+            }
+            sort(nbrs.begin(), nbrs.end());
+            for (int i = 0; i < nbrs.size(); ++i)
+                zorder.push_back(nbrs[i].second);
+        }
+    }
+
+    reverse(zorder.begin(), zorder.end());
+
+}
+
+
+int MeshOrder::calcLevels(
+        const int root,
+        const vector<int>& adjstart,
+        const vector<int>& adj,
+        vector<int>& level,
+        vector<int>& lastlevel) {
+
+    vector<int> queue(1, root);
+    level[root] = 0;
+    int head = 0;
+    while (head < queue.size()) {
+        int z = queue[head];
+        head += 1;
+        for (int i = adjstart[z]; i < adjstart[z+1]; ++i) {
+            int z2 = adj[i];
+            if (level[z2] >= 0) continue;
+            level[z2] = level[z] + 1;
+            queue.push_back(z2);
+        }
+    }
+
+    const int nlev = level[queue.back()] + 1;
+    lastlevel.resize(0);
+    for (int i = 0; i < queue.size(); ++i) {
+        int z = queue[i];
+        if (level[z] == nlev - 1) lastlevel.push_back(z);
+        // reset for the next search
+        level[z] = -1;
+    }
+    return nlev;
+
+}
+
+
+void MeshOrder::calcZoneAdj(
+        const vector<int>& zonestart,
+        const vector<int>& zonesize,
+        const vector<int>& zonepoints,
+        vector<int>& adjstart,
+        vector<int>& adj) {
+
+    const int numz = zonestart.size();
+
+    // list the edge of each side by its points, lowest first;
+    // after sorting, the two sides on an interior edge are together
+    vector<pair<pair<int, int>, int> > edgez;
+    edgez.reserve(zonepoints.size());
+    for (int z = 0; z < numz; ++z) {
+        int sfirst = zonestart[z];
+        int size = zonesize[z];
+        for (int i = 0; i < size; ++i) {
+            int p1 = zonepoints[sfirst + i];
+            int p2 = zonepoints[sfirst + (i + 1) % size];
+            edgez.push_back(make_pair(
+                    make_pair(min(p1, p2), max(p1, p2)), z));
+        }
+    }
+    sort(edgez.begin(), edgez.end());
+
+    vector<pair<int, int> > zz;
+    for (int i = 0; i + 1 < edgez.size(); ++i) {
+        if (edgez[i].first != edgez[i+1].first) continue;
+        int z1 = edgez[i].second;
+        int z2 = edgez[i+1].second;
+        zz.push_back(make_pair(z1, z2));
+        zz.push_back(make_pair(z2, z1));
+        i += 1;
+    }
+    sort(zz.begin(), zz.end());
+
+    adjstart.assign(numz + 1, 0);
+    adj.resize(zz.size());
+    for (int i = 0; i < zz.size(); ++i) {
+        adjstart[zz[i].first + 1] += 1;
+        adj[i] = zz[i].second;
+    }
+    for (int z = 0; z < numz; ++z)
+        adjstart[z + 1] += adjstart[z];
+
+}
+
+
+void MeshOrder::calcLocality(
+        const int nump,
+        const vector<int>& zonestart,
+        const vector<int>& zonesize,
+        const vector<int>& zonepoints,
+        double& spdist,
+        double& pcspan,
+        double& zzdist) {
+
+    const int nums = zonepoints.size();
+
+    double dsum = 0.;
+    int64_t dcount = max(nums - 1, 0);
+    for (int s = 1; s < nums; ++s)
+        dsum += abs(zonepoints[s] - zonepoints[s - 1]);
+
+    vector<int> cmin(nump, nums), cmax(nump, -1);
+    for (int c = 0; c < nums; ++c) {
+        int p = zonepoints[c];
+        cmin[p] = min(cmin[p], c);
+        cmax[p] = max(cmax[p], c);
+    }
+    double ssum = 0.;
+    int64_t scount = 0;
+    for (int p = 0; p < nump; ++p) {
+        if (cmax[p] < 0) continue;
+        ssum += cmax[p] - cmin[p];
+        scount += 1;
+    }
+
+    vector<int> adjstart, adj;
+    calcZoneAdj(zonestart, zonesize, zonepoints, adjstart, adj);
+    double zsum = 0.;
+    int64_t zcount = adj.size();
+    for (int z = 0; z + 1 < adjstart.size(); ++z)
+        for (int i = adjstart[z]; i < adjstart[z+1]; ++i)
+            zsum += abs(adj[i] - z);
+
+    Parallel::globalSum(dsum);
+    Parallel::globalSum(dcount);
+    Parallel::globalSum(ssum);
+    Parallel::globalSum(scount);
+    Parallel::globalSum(zsum);
+    Parallel::globalSum(zcount);
+    spdist = (dcount > 0 ? dsum / dcount : 0.);
+    pcspan = (scount > 0 ? ssum / scount : 0.);
+    zzdist = (zcount > 0 ? zsum / zcount : 0.);
+
+}
+
+
+uint64_t MeshOrder::hilbertKey(
+        const int bits,
+        uint32_t x,
+        uint32_t y) {
+
+    const uint32_t n = (uint32_t) 1 << bits;
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = ((x & s) > 0);
+        uint32_t ry = ((y & s) > 0);
+        d += (uint64_t) s * s * ((3 * rx) ^ ry);
+        // rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+
+}
+
+
+uint64_t MeshOrder::mortonKey(
+        const int bits,
+        uint32_t x,
+        uint32_t y) {
+
+    uint64_t d = 0;
+    for (int b = 0; b < bits; ++b) {
+        d |= (uint64_t) ((x >> b) & 1) << (2 * b);
+        d |= (uint64_t) ((y >> b) & 1) << (2 * b + 1);
+    }
+    return d;
+
+}
@@ -0,0 +1,119 @@
+/*
+ * MeshOrder.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef MESHORDER_HH_
+#define MESHORDER_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Vec2.hh"
+
+// forward declarations
+class InputFile;
+
+
+// Class MeshOrder renumbers the zones and points of a generated
+// mesh before the mesh data structures are built from it, so that
+// zones near each other (and the points they use) are near each
+// other in memory.  Zones are sorted either along a space-filling
+// curve through their centers, or by reverse Cuthill-McKee on the
+// graph of zones that share an edge; points are then numbered in
+// the order that the renumbered zones first use them.  Each zone
+// keeps its own list of points, in the same order, so sides are
+// unchanged apart from their numbering.
+
+class MeshOrder {
+public:
+
+    std::string order;             // zone ordering:  "none",
+                                   // "hilbert", "morton" or "rcm"
+    bool quiet;                    // flag:  suppress output?
+
+    MeshOrder(const InputFile* inp);
+    ~MeshOrder();
+
+    // renumber zones and points in place; zoneorig receives the
+    // original index of each zone, or is left empty if the order
+    // is unchanged
+    void reorder(
+            std::vector<double2>& pointpos,
+            std::vector<int>& zonestart,
+            std::vector<int>& zonesize,
+            std::vector<int>& zonepoints,
+            std::vector<int>& slavepoints,
+            std::vector<int>& masterpoints,
+            std::vector<int>& zoneorig);
+
+private:
+
+    // find the new zone order along a space-filling curve; zorder
+    // receives the original index of each zone in the new order
+    void calcCurveOrder(
+            const std::vector<double2>& pointpos,
+            const std::vector<int>& zonestart,
+            const std::vector<int>& zonesize,
+            const std::vector<int>& zonepoints,
+            std::vector<int>& zorder);
+
+    // find the new zone order by reverse Cuthill-McKee
+    void calcRCMOrder(
+            const std::vector<int>& adjstart,
+            const std::vector<int>& adj,
+            std::vector<int>& zorder);
+
+    // breadth-first search from zone root, used to find a starting
+    // zone for RCM; returns the number of levels, and puts the zones
+    // in the last level in lastlevel
+    int calcLevels(
+            const int root,
+            const std::vector<int>& adjstart,
+            const std::vector<int>& adj,
+            std::vector<int>& level,
+            std::vector<int>& lastlevel);
+
+    // find the zones sharing an edge with each zone; the neighbors
+    // of zone z are adj[adjstart[z]] through adj[adjstart[z+1]-1]
+    void calcZoneAdj(
+            const std::vector<int>& zonestart,
+            const std::vector<int>& zonesize,
+            const std::vector<int>& zonepoints,
+            std::vector<int>& adjstart,
+            std::vector<int>& adj);
+
+    // measures of gather locality for the current numbering,
+    // averaged over all PEs:
+    // spdist = mean distance between the point indices of
+    //          consecutive sides
+    // pcspan = mean distance between the first and last corner
+    //          of each point
+    // zzdist = mean distance between the zone indices on either
+    //          side of an interior side
+    void calcLocality(
+            const int nump,
+            const std::vector<int>& zonestart,
+            const std::vector<int>& zonesize,
+            const std::vector<int>& zonepoints,
+            double& spdist,
+            double& pcspan,
+            double& zzdist);
+
+    // position of (x, y) along a Hilbert curve through a
+    // 2^bits by 2^bits grid
+    static uint64_t hilbertKey(const int bits, uint32_t x, uint32_t y);
+
+    // position of (x, y) along a Morton (Z-order) curve
+    static uint64_t mortonKey(const int bits, uint32_t x, uint32_t y);
+
+};  // class MeshOrder
+
+
+#endif /* MESHORDER_HH_ */
@@ -0,0 +1,138 @@
+/*
+ * Numa.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Numa.hh"
+
+#include <stdint.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+
+bool Numa::pinThreads() {
+
+#ifdef _OPENMP
+    // inside a parallel region, as for each problem of an ensemble,
+    // the team here is just the calling thread, and every caller
+    // would pin itself to the first CPU
+    if (omp_in_parallel()) return false;
+#endif
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return false;
+    vector<int> cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &mask)) cpus.push_back(c);
+    if (cpus.empty()) return false;
+
+    bool ok = true;
+    #pragma omp parallel reduction(&&:ok)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        cpu_set_t tmask;
+        CPU_ZERO(&tmask);
+        CPU_SET(cpus[t % cpus.size()], &tmask);
+        // pid 0 is the calling thread
+        ok = (sched_setaffinity(0, sizeof(tmask), &tmask) == 0);
+    }
+    return ok;
+#else
+    return false;
+#endif
+
+}
+
+
+void Numa::getThreadNodes(vector<int>& nodes) {
+
+    int numthr = 1;
+#ifdef _OPENMP
+    numthr = omp_get_max_threads();
+#endif
+    nodes.assign(numthr, -1);
+
+#if defined(__linux__) && defined(SYS_getcpu)
+    #pragma omp parallel
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        unsigned cpu, node;
+        if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+            nodes[t] = node;
+    }
+#endif
+
+}
+
+
+bool Numa::getPageNodes(
+        const void* ptr,
+        const size_t bytes,
+        vector<int>& nodes) {
+
+    nodes.resize(0);
+#if defined(__linux__) && defined(SYS_move_pages)
+    const size_t psize = pageSize();
+    const uintptr_t first = (uintptr_t) ptr / psize * psize;
+    const uintptr_t last = (uintptr_t) ptr + bytes;
+    const size_t n = (last - first + psize - 1) / psize;
+    vector<void*> pages(n);
+    for (size_t i = 0; i < n; ++i)
+        pages[i] = (void*) (first + i * psize);
+    vector<int> status(n);
+
+    // with no target nodes, move_pages only reports where each
+    // page is, or a negative error number if it has none yet
+    if (n > 0 && syscall(SYS_move_pages, 0, n, &pages[0], NULL,
+            &status[0], 0) != 0)
+        return false;
+    nodes.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        nodes[i] = (status[i] >= 0 ? status[i] : -1);
+    return true;
+#else
+    return false;
+#endif
+
+}
+
+
+size_t Numa::pageSize() {
+    return sysconf(_SC_PAGESIZE);
+}
+
+
+void Numa::useFreshPages() {
+
+#ifdef __GLIBC__
+    // a fixed threshold keeps glibc from raising it each time a
+    // large array is freed, which would let the next large array
+    // come from reused heap pages instead of a new mapping
+    mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+#endif
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Numa.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef NUMA_HH_
+#define NUMA_HH_
+
+#include <cstddef>
+#include <vector>
+
+
+// Namespace Numa wraps the operating system calls used to place
+// arrays on NUMA nodes (see Mesh::placeArrays) and to find out
+// where they are.  Where these calls are not available, threads
+// are left unpinned and placement is reported as unknown.
+
+namespace Numa {
+
+    // bind OpenMP thread t to the t-th CPU of the process's
+    // affinity mask (wrapping around if there are more threads
+    // than CPUs); returns false if not supported, or if called
+    // inside a parallel region
+    bool pinThreads();
+
+    // NUMA node that each OpenMP thread is running on, indexed
+    // by thread number (-1 if unknown)
+    void getThreadNodes(std::vector<int>& nodes);
+
+    // NUMA node of each page in [ptr, ptr + bytes), or -1 for a
+    // page not yet touched; returns false if not supported
+    bool getPageNodes(
+            const void* ptr,
+            const size_t bytes,
+            std::vector<int>& nodes);
+
+    size_t pageSize();
+
+    // have malloc return every large array on fresh pages, rather
+    // than on pages freed by another array, so that the first
+    // touch of the new array decides where its pages go
+    void useFreshPages();
+
+}  // namespace Numa
+
+
+#endif /* NUMA_HH_ */
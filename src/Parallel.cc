@@ -32,10 +32,21 @@ int numpe = 1;
 int mype = 0;
 #endif
 
+#ifdef USE_MPI
+// did init() start MPI, so that final() should stop it?
+static bool ownmpi = false;
+#endif
+
 
 void init() {
 #ifdef USE_MPI
-    MPI_Init(0, 0);
+    // an application embedding PENNANT may have started MPI already
+    int flag;
+    MPI_Initialized(&flag);
+    if (!flag) {
+        MPI_Init(0, 0);
+        ownmpi = true;
+    }
     MPI_Comm_size(MPI_COMM_WORLD, &numpe);
     MPI_Comm_rank(MPI_COMM_WORLD, &mype);
 #endif
@@ -44,11 +55,19 @@ void init() {
 
 void final() {
 #ifdef USE_MPI
-    MPI_Finalize();
+    if (ownmpi) MPI_Finalize();
 #endif
 }  // final
 
 
+void barrier() {
+    if (numpe == 1) return;
+#ifdef USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}  // barrier
+
+
 void globalMinLoc(double& x, int& xpe) {
     if (numpe == 1) {
         xpe = 0;
@@ -99,6 +118,26 @@ void globalSum(double& x) {
 }
 
 
+void globalMin(double& x) {
+    if (numpe == 1) return;
+#ifdef USE_MPI
+    double y;
+    MPI_Allreduce(&x, &y, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    x = y;
+#endif
+}
+
+
+void globalMax(double& x) {
+    if (numpe == 1) return;
+#ifdef USE_MPI
+    double y;
+    MPI_Allreduce(&x, &y, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    x = y;
+#endif
+}
+
+
 void gather(int x, int* y) {
     if (numpe == 1) {
         y[0] = x;
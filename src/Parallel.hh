@@ -30,8 +30,10 @@ namespace Parallel {
     extern int mype;            // PE number for my rank
                                 // (0 if not using MPI)
 
-    void init();                // initialize MPI
-    void final();               // finalize MPI
+    void init();                // initialize MPI, unless already
+                                // initialized by the application
+    void final();               // finalize MPI, if init() did
+    void barrier();             // synchronize all PEs
 
     void globalMinLoc(double& x, int& xpe);
                                 // find minimum over all PEs, and
@@ -39,6 +41,8 @@ namespace Parallel {
     void globalSum(int& x);     // find sum over all PEs - overloaded
     void globalSum(int64_t& x);
     void globalSum(double& x);
+    void globalMin(double& x);  // find min over all PEs
+    void globalMax(double& x);  // find max over all PEs
     void gather(const int x, int* y);
                                 // gather list of ints from all PEs
     void scatter(const int* x, int& y);
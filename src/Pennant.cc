@@ -0,0 +1,196 @@
+/*
+ * Pennant.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Pennant.hh"
+
+#include "InputFile.hh"
+#include "Driver.hh"
+#include "Mesh.hh"
+#include "Hydro.hh"
+
+using namespace std;
+
+
+Pennant::Pennant(const InputFile* inp, const string& pname)
+        : finished(false) {
+
+    // start now, so that chunk tuning and array placement, which
+    // reallocate arrays, are done before any view is taken
+    drv = new Driver(inp, pname);
+    drv->start();
+
+}
+
+
+Pennant::~Pennant() {
+    finish();
+    delete drv;
+}
+
+
+int Pennant::advance(const int n) {
+
+    int k = 0;
+    while (k < n && !drv->done()) {
+        drv->step();
+        k += 1;
+    }
+    return k;
+
+}
+
+
+bool Pennant::done() const {
+    return drv->done();
+}
+
+
+void Pennant::finish() {
+
+    if (finished) return;
+    drv->finish();
+    finished = true;
+
+}
+
+
+int Pennant::cycle() const { return drv->cycle; }
+
+double Pennant::time() const { return drv->time; }
+
+double Pennant::dt() const { return drv->dt; }
+
+const string& Pennant::dtLimiter() const { return drv->msgdt; }
+
+
+double Pennant::nextDt() {
+
+    // compute as for the next cycle, then put everything back
+    const double dt0 = drv->dt;
+    const double dtlast0 = drv->dtlast;
+    const string msgdt0 = drv->msgdt;
+    const string msgdtlast0 = drv->msgdtlast;
+
+    drv->cycle += 1;
+    drv->calcGlobalDt();
+    double dtnext = drv->dt;
+    drv->cycle -= 1;
+
+    drv->dt = dt0;
+    drv->dtlast = dtlast0;
+    drv->msgdt = msgdt0;
+    drv->msgdtlast = msgdtlast0;
+    return dtnext;
+
+}
+
+
+Mesh* Pennant::mesh() { return drv->mesh; }
+
+Hydro* Pennant::hydro() { return drv->hydro; }
+
+
+int Pennant::numPoints() const { return drv->mesh->nump; }
+
+int Pennant::numEdges() const { return drv->mesh->nume; }
+
+int Pennant::numZones() const { return drv->mesh->numz; }
+
+int Pennant::numSides() const { return drv->mesh->nums; }
+
+
+ConstDouble2View Pennant::px() const {
+    return ConstDouble2View(drv->mesh->px, drv->mesh->nump);
+}
+
+ConstDouble2View Pennant::ex() const {
+    return ConstDouble2View(drv->mesh->ex,
+            (drv->mesh->leanmem ? 0 : drv->mesh->nume));
+}
+
+ConstDouble2View Pennant::zx() const {
+    return ConstDouble2View(drv->mesh->zx, drv->mesh->numz);
+}
+
+ArrayView<const double> Pennant::sarea() const {
+    return ArrayView<const double>(drv->mesh->sarea,
+            (drv->mesh->leanmem ? 0 : drv->mesh->nums));
+}
+
+ArrayView<const double> Pennant::svol() const {
+    return ArrayView<const double>(drv->mesh->svol,
+            (drv->mesh->leanmem ? 0 : drv->mesh->nums));
+}
+
+ArrayView<const double> Pennant::zarea() const {
+    return ArrayView<const double>(drv->mesh->zarea, drv->mesh->numz);
+}
+
+ArrayView<const double> Pennant::zvol() const {
+    return ArrayView<const double>(drv->mesh->zvol, drv->mesh->numz);
+}
+
+ArrayView<const int> Pennant::mapsp1() const {
+    return ArrayView<const int>(drv->mesh->mapsp1, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::mapsp2() const {
+    return ArrayView<const int>(drv->mesh->mapsp2, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::mapsz() const {
+    return ArrayView<const int>(drv->mesh->mapsz, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::mapse() const {
+    return ArrayView<const int>(drv->mesh->mapse, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::mapss3() const {
+    return ArrayView<const int>(drv->mesh->mapss3, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::mapss4() const {
+    return ArrayView<const int>(drv->mesh->mapss4, drv->mesh->nums);
+}
+
+ArrayView<const int> Pennant::znump() const {
+    return ArrayView<const int>(drv->mesh->znump, drv->mesh->numz);
+}
+
+
+Double2View Pennant::pu() const {
+    return Double2View(drv->hydro->pu, drv->mesh->nump);
+}
+
+ArrayView<double> Pennant::zr() const {
+    return ArrayView<double>(drv->hydro->zr, drv->mesh->numz);
+}
+
+ArrayView<double> Pennant::ze() const {
+    return ArrayView<double>(drv->hydro->ze, drv->mesh->numz);
+}
+
+ArrayView<double> Pennant::zp() const {
+    return ArrayView<double>(drv->hydro->zp, drv->mesh->numz);
+}
+
+ArrayView<double> Pennant::zm() const {
+    return ArrayView<double>(drv->hydro->zm, drv->mesh->numz);
+}
+
+ArrayView<double> Pennant::zetot() const {
+    return ArrayView<double>(drv->hydro->zetot, drv->mesh->numz);
+}
+
+ArrayView<double> Pennant::zss() const {
+    return ArrayView<double>(drv->hydro->zss, drv->mesh->numz);
+}
@@ -0,0 +1,143 @@
+/*
+ * Pennant.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef PENNANT_HH_
+#define PENNANT_HH_
+
+#include <string>
+
+#include "Vec2Array.hh"
+
+// forward declarations
+class InputFile;
+class Driver;
+class Mesh;
+class Hydro;
+
+
+// view of an array owned by PENNANT; no data is copied
+template <typename T>
+struct ArrayView {
+    T* data;                       // first element
+    int size;                      // number of elements
+
+    ArrayView(T* d, const int n) : data(d), size(n) {}
+
+    T& operator[](const int i) const { return data[i]; }
+    T* begin() const { return data; }
+    T* end() const { return data + size; }
+};
+
+
+// view of a double2 array owned by PENNANT, in either storage
+// layout (see Vec2Array.hh); P is the array type and R the type
+// of one element
+template <typename P, typename R>
+struct ArrayView2 {
+    P data;                        // array
+    int size;                      // number of elements
+
+    ArrayView2(P d, const int n) : data(d), size(n) {}
+
+    R operator[](const int i) const { return data[i]; }
+};
+
+typedef ArrayView2<const_double2ptr, const_double2ref> ConstDouble2View;
+typedef ArrayView2<double2ptr, double2ref> Double2View;
+
+
+// Class Pennant is the interface for running PENNANT inside another
+// application, which links with libpennant.a (see "make lib").
+// The application calls Parallel::init() before creating a problem
+// and Parallel::final() at the end; both leave MPI alone if the
+// application manages it.  A problem is created from an InputFile,
+// then advanced any number of cycles at a time.  The constructor
+// also does the setup that moves arrays (chunksize tuning and NUMA
+// placement), so mesh and hydro arrays are available as views of
+// the arrays used by the code itself, valid for the life of the
+// object.  Mesh views are read-only; changes made through the hydro
+// views are used by the next cycle.  All calls except the views are
+// collective over PEs.
+
+class Pennant {
+public:
+
+    Pennant(const InputFile* inp, const std::string& pname);
+    ~Pennant();
+
+    // advance up to n cycles, stopping early at cstop or tstop;
+    // returns the number of cycles taken
+    int advance(const int n);
+
+    // has the problem reached cstop or tstop?
+    bool done() const;
+
+    // write end-of-run reports and final mesh output; called
+    // by the destructor if not called before
+    void finish();
+
+    int cycle() const;             // cycles taken so far
+    double time() const;           // simulation time
+    double dt() const;             // timestep of last cycle
+    const std::string& dtLimiter() const;
+                                   // what limited the last timestep
+
+    // timestep that the next cycle would take, if not cut
+    // short by tstop
+    double nextDt();
+
+    // underlying objects, for access beyond the views below
+    Driver* driver() { return drv; }
+    Mesh* mesh();
+    Hydro* hydro();
+
+    // mesh sizes on this PE
+    int numPoints() const;
+    int numEdges() const;
+    int numZones() const;
+    int numSides() const;
+
+    // mesh coordinates, geometry and connectivity; ex, sarea and
+    // svol are empty if the input sets leanmem
+    ConstDouble2View px() const;
+    ConstDouble2View ex() const;
+    ConstDouble2View zx() const;
+    ArrayView<const double> sarea() const;
+    ArrayView<const double> svol() const;
+    ArrayView<const double> zarea() const;
+    ArrayView<const double> zvol() const;
+    ArrayView<const int> mapsp1() const;
+    ArrayView<const int> mapsp2() const;
+    ArrayView<const int> mapsz() const;
+    ArrayView<const int> mapse() const;
+    ArrayView<const int> mapss3() const;
+    ArrayView<const int> mapss4() const;
+    ArrayView<const int> znump() const;
+
+    // hydro state; ze and zetot must be kept consistent
+    // (zetot = ze * zm)
+    Double2View pu() const;
+    ArrayView<double> zr() const;
+    ArrayView<double> ze() const;
+    ArrayView<double> zp() const;
+    ArrayView<double> zm() const;
+    ArrayView<double> zetot() const;
+    ArrayView<double> zss() const;
+
+private:
+
+    Driver* drv;
+    bool finished;                 // has Driver::finish been called?
+
+};  // class Pennant
+
+
+#endif /* PENNANT_HH_ */
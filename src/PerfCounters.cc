@@ -0,0 +1,279 @@
+/*
+ * PerfCounters.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "PerfCounters.hh"
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "Parallel.hh"
+
+using namespace std;
+
+
+const char* PerfCounters::eventname[PerfCounters::NUMEVENTS] = {
+    "cycles",
+    "instructions",
+    "llc-misses",
+    "stall-cycles",
+    "dtlb-misses"
+};
+
+
+PerfCounters::PerfCounters(const int nthr, const int nreg)
+    : enabled(false), numthr(nthr), numreg(nreg) {
+
+    stride = NUMEVENTS + 8;
+    fd.resize(numthr * NUMEVENTS, -1);
+    evavail.resize(NUMEVENTS, 0);
+    multiplexed.resize(numthr, 0);
+    last.resize(numthr * stride, 0);
+    count.resize(numthr * numreg * NUMEVENTS, 0);
+
+#ifndef __linux__
+    errmsg = "perf_event_open not available on this system";
+#endif
+
+}
+
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < fd.size(); ++i)
+        if (fd[i] >= 0) close(fd[i]);
+#endif
+}
+
+
+void PerfCounters::openThread(const int thr) {
+#ifdef __linux__
+    static const uint32_t evtype[NUMEVENTS] = {
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE
+    };
+    static const uint64_t evconfig[NUMEVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+        PERF_COUNT_HW_CACHE_DTLB |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    int* thrfd = &fd[thr * NUMEVENTS];
+    for (int ev = 0; ev < NUMEVENTS; ++ev) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = evtype[ev];
+        attr.config = evconfig[ev];
+        attr.read_format = PERF_FORMAT_GROUP |
+                PERF_FORMAT_TOTAL_TIME_ENABLED |
+                PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // the first event (cycles) is the group leader; if it
+        // can't be opened, no other events are attempted
+        int leader = (ev == 0 ? -1 : thrfd[0]);
+        if (ev > 0 && leader < 0) break;
+        // pid = 0, cpu = -1:  count calling thread on any CPU
+        thrfd[ev] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                leader, 0);
+        if (thrfd[ev] < 0 && ev == 0) {
+            #pragma omp critical
+            errmsg = string("perf_event_open failed: ") +
+                    strerror(errno);
+        }
+    }
+#endif
+}
+
+
+void PerfCounters::finishOpen() {
+
+    // an event is only reported if every thread has it
+    for (int ev = 0; ev < NUMEVENTS; ++ev) {
+        evavail[ev] = 1;
+        for (int thr = 0; thr < numthr; ++thr)
+            if (fd[thr * NUMEVENTS + ev] < 0) evavail[ev] = 0;
+    }
+    enabled = evavail[EV_CYCLES];
+
+}
+
+
+bool PerfCounters::readGroup(const int thr, uint64_t* vals) {
+#ifdef __linux__
+    // layout for PERF_FORMAT_GROUP with enabled/running times:
+    // { nr, time_enabled, time_running, value[nr] }
+    uint64_t buf[3 + NUMEVENTS];
+    const int* thrfd = &fd[thr * NUMEVENTS];
+    ssize_t n = read(thrfd[0], buf, sizeof(buf));
+    if (n < (ssize_t) (3 * sizeof(uint64_t))) return false;
+    if (buf[2] < buf[1]) multiplexed[thr] = 1;
+    int i = 0;
+    for (int ev = 0; ev < NUMEVENTS; ++ev) {
+        if (thrfd[ev] >= 0 && i < buf[0])
+            vals[ev] = buf[3 + i++];
+        else
+            vals[ev] = 0;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void PerfCounters::start(const int thr) {
+    if (!enabled) return;
+    readGroup(thr, &last[thr * stride]);
+}
+
+
+void PerfCounters::lap(const int thr, const int reg) {
+    if (!enabled) return;
+    uint64_t vals[NUMEVENTS];
+    if (!readGroup(thr, vals)) return;
+    uint64_t* thrlast = &last[thr * stride];
+    uint64_t* thrcount = &count[(thr * numreg + reg) * NUMEVENTS];
+    for (int ev = 0; ev < NUMEVENTS; ++ev) {
+        thrcount[ev] += vals[ev] - thrlast[ev];
+        thrlast[ev] = vals[ev];
+    }
+}
+
+
+void PerfCounters::reset() {
+    fill(count.begin(), count.end(), 0);
+}
+
+
+bool PerfCounters::getTotal(const int ev, double& total) {
+
+    double avail = (enabled && evavail[ev] ? 1. : 0.);
+    Parallel::globalMin(avail);
+    total = 0.;
+    if (avail == 0.) return false;
+    for (int thr = 0; thr < numthr; ++thr)
+        for (int reg = 0; reg < numreg; ++reg)
+            total += count[(thr * numreg + reg) * NUMEVENTS + ev];
+    Parallel::globalSum(total);
+    return true;
+
+}
+
+
+void PerfCounters::write(
+        const char* const* regname,
+        const double* regtime) {
+
+    using Parallel::mype;
+
+    // all PEs must agree on whether to do the reductions
+    double penabled = (enabled ? 1. : 0.);
+    Parallel::globalMin(penabled);
+    if (penabled == 0.) {
+        if (mype == 0) {
+            cout << endl;
+            cout << "Hardware counters unavailable";
+            if (!errmsg.empty()) cout << " (" << errmsg << ")";
+            cout << endl;
+        }
+        return;
+    }
+
+    // sum over threads and PEs
+    vector<double> sum(numreg * NUMEVENTS, 0.);
+    for (int reg = 0; reg < numreg; ++reg) {
+        for (int ev = 0; ev < NUMEVENTS; ++ev) {
+            double x = 0.;
+            for (int thr = 0; thr < numthr; ++thr)
+                x += count[(thr * numreg + reg) * NUMEVENTS + ev];
+            Parallel::globalSum(x);
+            sum[reg * NUMEVENTS + ev] = x;
+        }
+    }
+    double mplx = 0.;
+    for (int thr = 0; thr < numthr; ++thr)
+        mplx += multiplexed[thr];
+    Parallel::globalSum(mplx);
+    vector<double> avail(evavail.begin(), evavail.end());
+    for (int ev = 0; ev < NUMEVENTS; ++ev)
+        Parallel::globalMin(avail[ev]);
+
+    if (mype > 0) return;
+
+    cout << endl;
+    cout << "--- Hardware Counters (summed over threads, PEs) ---"
+         << endl;
+    cout << left << setw(16) << "phase" << right
+         << setw(11) << "Gcycles" << setw(11) << "Ginstr"
+         << setw(7) << "IPC" << setw(11) << "LLC miss"
+         << setw(8) << "MPKI" << setw(8) << "stall%"
+         << setw(9) << "GB/s" << setw(11) << "TLB MPKI" << endl;
+    for (int reg = 0; reg < numreg; ++reg) {
+        const double* s = &sum[reg * NUMEVENTS];
+        if (s[EV_CYCLES] == 0.) continue;
+        cout << left << setw(16) << regname[reg] << right;
+        cout << fixed << setprecision(4);
+        cout << setw(11) << s[EV_CYCLES] * 1.e-9;
+        if (avail[EV_INSTR]) {
+            cout << setw(11) << s[EV_INSTR] * 1.e-9;
+            cout << setprecision(2);
+            cout << setw(7) << s[EV_INSTR] / s[EV_CYCLES];
+        }
+        else
+            cout << setw(11) << "n/a" << setw(7) << "n/a";
+        if (avail[EV_LLCMISS]) {
+            cout << scientific << setprecision(3);
+            cout << setw(11) << s[EV_LLCMISS];
+            cout << fixed << setprecision(2);
+            cout << setw(8) << (avail[EV_INSTR] && s[EV_INSTR] > 0. ?
+                    1000. * s[EV_LLCMISS] / s[EV_INSTR] : 0.);
+        }
+        else
+            cout << setw(11) << "n/a" << setw(8) << "n/a";
+        if (avail[EV_STALL])
+            cout << setw(8) << 100. * s[EV_STALL] / s[EV_CYCLES];
+        else
+            cout << setw(8) << "n/a";
+        // estimate of memory traffic:  one 64-byte line per miss
+        if (avail[EV_LLCMISS] && regtime[reg] > 0.)
+            cout << setw(9)
+                 << 64. * s[EV_LLCMISS] / regtime[reg] * 1.e-9;
+        else
+            cout << setw(9) << "n/a";
+        if (avail[EV_DTLBMISS] && avail[EV_INSTR] && s[EV_INSTR] > 0.)
+            cout << setw(11) << 1000. * s[EV_DTLBMISS] / s[EV_INSTR];
+        else
+            cout << setw(11) << "n/a";
+        cout << endl;
+    }
+    if (mplx > 0.)
+        cout << "(warning: counters were multiplexed on "
+             << mplx << " thread(s); counts are not scaled)" << endl;
+    cout << "------------------------" << endl;
+
+}
@@ -0,0 +1,96 @@
+/*
+ * PerfCounters.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef PERFCOUNTERS_HH_
+#define PERFCOUNTERS_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+// Class PerfCounters reads hardware performance counters through
+// the Linux perf_event_open interface.  Each thread opens its own
+// group of counters, and the deltas between successive readings
+// are accumulated into per-thread, per-region totals.  If the
+// counters can't be opened (non-Linux system, insufficient
+// permissions, virtualized PMU, ...), the object is left disabled
+// and all calls become no-ops.
+
+class PerfCounters {
+public:
+
+    enum Event {
+        EV_CYCLES,        // CPU cycles
+        EV_INSTR,         // instructions retired
+        EV_LLCMISS,       // last-level cache misses
+        EV_STALL,         // backend stall cycles
+        EV_DTLBMISS,      // data TLB load misses
+        NUMEVENTS
+    };
+    static const char* eventname[NUMEVENTS];
+
+    bool enabled;                  // flag:  counters opened and usable?
+    std::string errmsg;            // reason counters are disabled
+    int numthr;                    // number of threads
+    int numreg;                    // number of regions
+    int stride;                    // distance between thread slots
+    std::vector<int> fd;           // counter file descriptors, by
+                                   // [thread * NUMEVENTS + event]
+                                   // (-1 if event unavailable)
+    std::vector<int> evavail;      // flag:  event open on all threads?
+    std::vector<int> multiplexed;  // flag:  thread's group was ever
+                                   // not scheduled on the PMU?
+    std::vector<uint64_t> last;    // last reading, by
+                                   // [thread * stride + event]
+    std::vector<uint64_t> count;   // accumulated counts, by
+                                   // [(thread * numreg + region) *
+                                   //     NUMEVENTS + event]
+
+    PerfCounters(const int nthr, const int nreg);
+    ~PerfCounters();
+
+    // open counter group for calling thread; must be called
+    // by each thread from inside a parallel region
+    void openThread(const int thr);
+
+    // finish setup after all threads have opened their groups
+    void finishOpen();
+
+    // take a reading to start a region
+    void start(const int thr);
+
+    // take a reading and add deltas since the last one to
+    // the given region
+    void lap(const int thr, const int reg);
+
+    // zero all accumulators
+    void reset();
+
+    // sum of an event over all threads, regions and PEs; returns
+    // false if the event isn't available on every PE.  Must be
+    // called on all PEs.
+    bool getTotal(const int ev, double& total);
+
+    // reduce over threads and PEs, and write summary table
+    void write(
+            const char* const* regname,
+            const double* regtime);
+
+private:
+    // read current group values for a thread into vals;
+    // returns false on read error
+    bool readGroup(const int thr, uint64_t* vals);
+
+};  // class PerfCounters
+
+
+#endif /* PERFCOUNTERS_HH_ */
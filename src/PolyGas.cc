@@ -16,10 +16,32 @@
 #include "InputFile.hh"
 #include "Hydro.hh"
 #include "Mesh.hh"
+#include "SideMap.hh"
 
 using namespace std;
 
 
+namespace {
+
+// function object for dispatchSideMap (see SideMap.hh):  calls
+// calcForce's FieldsOne version with the side map given
+
+struct CalcForceOp {
+    const double* zp;
+    const_double2ptr ssurfp;
+    double2ptr sf;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        PolyGas::calcForce<FieldsOne>(sm, zp, ssurfp, sf, sfirst, slast);
+    }
+};
+
+}  // namespace
+
+
 PolyGas::PolyGas(const InputFile* inp, Hydro* h) : hydro(h) {
     gamma = inp->getDouble("gamma", 5. / 3.);
     ssmin = inp->getDouble("ssmin", 0.);
@@ -40,26 +62,49 @@ void PolyGas::calcStateAtHalf(
         const int zfirst,
         const int zlast) {
 
-    double* z0per = Memory::alloc<double>(zlast - zfirst);
+    calcStateAtHalf<FieldsOne>(gamma, ssmin, zr0, zvolp, zvol0, ze, zwrate,
+            zm, dt, zp, zss, zfirst, zlast);
+
+}
+
+
+template <typename FT>
+void PolyGas::calcStateAtHalf(
+        const typename FT::real gamma,
+        const typename FT::real ssmin,
+        typename FT::cptr zr0,
+        typename FT::cptr zvolp,
+        typename FT::cptr zvol0,
+        typename FT::cptr ze,
+        typename FT::cptr zwrate,
+        typename FT::cptr zm,
+        const typename FT::real dt,
+        typename FT::ptr zp,
+        typename FT::ptr zss,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real real;
+
+    Memory::ScratchScope scope;
+    real* z0per = FT::scratch(zlast - zfirst);
 
-    const double dth = 0.5 * dt;
+    const real dth = 0.5 * dt;
 
     // compute EOS at beginning of time step
-    calcEOS(zr0, ze, zp, z0per, zss, zfirst, zlast);
+    calcEOS<FT>(gamma, ssmin, zr0, ze, zp, z0per, zss, zfirst, zlast);
 
     // now advance pressure to the half-step
     #pragma ivdep
     for (int z = zfirst; z < zlast; ++z) {
         int z0 = z - zfirst;
-        double zminv = 1. / zm[z];
-        double dv = (zvolp[z] - zvol0[z]) * zminv;
-        double bulk = zr0[z] * zss[z] * zss[z];
-        double denom = 1. + 0.5 * z0per[z0] * dv;
-        double src = zwrate[z] * dth * zminv;
+        real zminv = 1. / zm[z];
+        real dv = (zvolp[z] - zvol0[z]) * zminv;
+        real bulk = zr0[z] * zss[z] * zss[z];
+        real denom = 1. + 0.5 * z0per[z0] * dv;
+        real src = zwrate[z] * dth * zminv;
         zp[z] += (z0per[z0] * src - zr0[z] * bulk * dv) / denom;
     }
-
-    Memory::free(z0per);
 }
 
 
@@ -72,18 +117,37 @@ void PolyGas::calcEOS(
         const int zfirst,
         const int zlast) {
 
-    const double gm1 = gamma - 1.;
-    const double ss2 = max(ssmin * ssmin, 1.e-99);
+    calcEOS<FieldsOne>(gamma, ssmin, zr, ze, zp, z0per, zss, zfirst, zlast);
+
+}
+
+
+template <typename FT>
+void PolyGas::calcEOS(
+        const typename FT::real gamma,
+        const typename FT::real ssmin,
+        typename FT::cptr zr,
+        typename FT::cptr ze,
+        typename FT::ptr zp,
+        typename FT::ptr z0per,
+        typename FT::ptr zss,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real real;
+
+    const real gm1 = gamma - 1.;
+    const real ss2 = max(ssmin * ssmin, 1.e-99);
 
     #pragma ivdep
     for (int z = zfirst; z < zlast; ++z) {
         int z0 = z - zfirst;
-        double rx = zr[z];
-        double ex = max(ze[z], 0.0);
-        double px = gm1 * rx * ex;
-        double prex = gm1 * ex;
-        double perx = gm1 * rx;
-        double csqd = max(ss2, prex + perx * px / (rx * rx));
+        real rx = zr[z];
+        real ex = max(ze[z], 0.0);
+        real px = gm1 * rx * ex;
+        real prex = gm1 * ex;
+        real perx = gm1 * rx;
+        real csqd = max(ss2, prex + perx * px / (rx * rx));
         zp[z] = px;
         z0per[z0] = perx;
         zss[z] = sqrt(csqd);
@@ -94,22 +158,50 @@ void PolyGas::calcEOS(
 
 void PolyGas::calcForce(
         const double* zp,
-        const double2* ssurfp,
-        double2* sf,
+        const_double2ptr ssurfp,
+        double2ptr sf,
         const int sfirst,
         const int slast) {
 
     const Mesh* mesh = hydro->mesh;
+    const CalcForceOp op = { zp, ssurfp, sf, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void PolyGas::calcForce(
+        const SM sm,
+        typename FT::cptr zp,
+        typename FT::cptr2 ssurfp,
+        typename FT::ptr2 sf,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real2 real2;
 
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int z = mesh->mapsz[s];
-        double2 sfx = -zp[z] * ssurfp[s];
+        int z = sm.zone(s);
+        real2 sfx = -zp[z] * ssurfp[s];
         sf[s] = sfx;
 
     }
 }
 
 
-
-
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES(FT) \
+    template void PolyGas::calcStateAtHalf<FT>(const FT::real, \
+            const FT::real, FT::cptr, FT::cptr, FT::cptr, FT::cptr, \
+            FT::cptr, FT::cptr, const FT::real, FT::ptr, FT::ptr, \
+            const int, const int);
+FOR_EACH_LANES(INSTANTIATE_LANES)
+#undef INSTANTIATE_LANES
+
+#define INSTANTIATE_LANES_SM(FT, SM) \
+    template void PolyGas::calcForce<FT, SM>(const SM, FT::cptr, \
+            FT::cptr2, FT::ptr2, const int, const int);
+FOR_EACH_LANES_SM(INSTANTIATE_LANES_SM)
+#undef INSTANTIATE_LANES_SM
@@ -13,7 +13,8 @@
 #ifndef POLYGAS_HH_
 #define POLYGAS_HH_
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
 
 // forward declarations
 class InputFile;
@@ -32,6 +33,10 @@ public:
     PolyGas(const InputFile* inp, Hydro* h);
     ~PolyGas();
 
+    // each kernel below has a plain version for this problem,
+    // which calls a static version templated on field types
+    // (see FieldTypes.hh) with FieldsOne
+
     void calcStateAtHalf(
             const double* zr0,
             const double* zvolp,
@@ -44,6 +49,21 @@ public:
             double* zss,
             const int zfirst,
             const int zlast);
+    template <typename FT>
+    static void calcStateAtHalf(
+            const typename FT::real gamma,
+            const typename FT::real ssmin,
+            typename FT::cptr zr0,
+            typename FT::cptr zvolp,
+            typename FT::cptr zvol0,
+            typename FT::cptr ze,
+            typename FT::cptr zwrate,
+            typename FT::cptr zm,
+            const typename FT::real dt,
+            typename FT::ptr zp,
+            typename FT::ptr zss,
+            const int zfirst,
+            const int zlast);
 
     void calcEOS(
             const double* zr,
@@ -53,11 +73,30 @@ public:
             double* zss,
             const int zfirst,
             const int zlast);
+    template <typename FT>
+    static void calcEOS(
+            const typename FT::real gamma,
+            const typename FT::real ssmin,
+            typename FT::cptr zr,
+            typename FT::cptr ze,
+            typename FT::ptr zp,
+            typename FT::ptr z0per,
+            typename FT::ptr zss,
+            const int zfirst,
+            const int zlast);
 
     void calcForce(
             const double* zp,
-            const double2* ssurfp,
-            double2* sf,
+            const_double2ptr ssurfp,
+            double2ptr sf,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void calcForce(
+            const SM sm,
+            typename FT::cptr zp,
+            typename FT::cptr2 ssurfp,
+            typename FT::ptr2 sf,
             const int sfirst,
             const int slast);
 
@@ -13,39 +13,164 @@
 #include "QCS.hh"
 
 #include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
 #include "Memory.hh"
+#include "Parallel.hh"
 #include "InputFile.hh"
 #include "Vec2.hh"
 #include "Mesh.hh"
+#include "SideMap.hh"
 #include "Hydro.hh"
+#include "Timer.hh"
 
 using namespace std;
 
 
+namespace {
+
+// function objects for dispatchSideMap (see SideMap.hh):  each
+// calls a kernel's FieldsOne version with the side map given
+
+struct SetCornerDivOp {
+    QCS* qcs;
+    double* c0area;
+    double* c0div;
+    double* c0evol;
+    double* c0du;
+    double* c0cos;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        qcs->setCornerDiv(sm, c0area, c0div, c0evol, c0du, c0cos, sfirst,
+                slast);
+    }
+};
+
+
+struct SetQCnForceOp {
+    QCS* qcs;
+    const double* c0div;
+    const double* c0du;
+    const double* c0evol;
+    double2ptr c0qe;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        qcs->setQCnForce(sm, c0div, c0du, c0evol, c0qe, sfirst, slast);
+    }
+};
+
+
+struct SetForceOp {
+    const double* elen;
+    const double* c0area;
+    const_double2ptr c0qe;
+    double* c0cos;
+    double2ptr sfq;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        QCS::setForce<FieldsOne>(sm, elen, c0area, c0qe, c0cos, sfq, sfirst,
+                slast);
+    }
+};
+
+
+struct SetVelDiffOp {
+    double q1;
+    double q2;
+    const_double2ptr px;
+    const_double2ptr pu;
+    const double* zss;
+    const double* elen;
+    double* zdu;
+    int sfirst;
+    int slast;
+    int zfirst;
+    int zlast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        QCS::setVelDiff<FieldsOne>(sm, q1, q2, px, pu, zss, elen, zdu, sfirst,
+                slast, zfirst, zlast);
+    }
+};
+
+}  // namespace
+
+
 QCS::QCS(const InputFile* inp, Hydro* h) : hydro(h) {
     qgamma = inp->getDouble("qgamma", 5. / 3.);
     q1 = inp->getDouble("q1", 0.);
     q2 = inp->getDouble("q2", 2.);
 
+    using Parallel::mype;
+    string simdname = inp->getString("qcssimd", "auto");
+    if (!QCSSimd::parseISA(simdname, simd)) {
+        if (mype == 0)
+            cerr << "Error:  qcssimd = " << simdname
+                 << " is unknown" << endl;
+        exit(1);
+    }
+    if (!QCSSimd::supported(simd)) {
+        if (mype == 0)
+            cerr << "Error:  qcssimd = " << simdname
+                 << " is not supported by this build or CPU" << endl;
+        exit(1);
+    }
+    // the Q vector loop is bound by its gathers and scatters, and
+    // measured no faster in SIMD form, so auto leaves it scalar
+    simdforce = (simd != QCSSimd::NONE && simdname != "auto");
+    simdtol = inp->getDouble("qcssimdcheck", 0.);
+    simdmaxdiff = 0.;
+
+}
+
+
+// SIMD loop input for a double2 array, in either storage layout
+static QCSSimd::Vec2In vec2In(const_double2ptr p) {
+    QCSSimd::Vec2In v;
+#ifdef USE_SOA
+    v.x = p.x;
+    v.y = p.y;
+    v.stride = 1;
+#else
+    v.x = &p[0].x;
+    v.y = &p[0].y;
+    v.stride = 2;
+#endif
+    return v;
 }
 
 QCS::~QCS() {}
 
 
 void QCS::calcForce(
-        double2* sf,
+        double2ptr sf,
         const int sfirst,
         const int slast) {
     int cfirst = sfirst;
     int clast = slast;
+    Timer* timer = hydro->mesh->timer;
+    double t0 = timer->start();
 
     // declare temporary variables
-    double* c0area = Memory::alloc<double>(clast - cfirst);
-    double* c0evol = Memory::alloc<double>(clast - cfirst);
-    double* c0du = Memory::alloc<double>(clast - cfirst);
-    double* c0div = Memory::alloc<double>(clast - cfirst);
-    double* c0cos = Memory::alloc<double>(clast - cfirst);
-    double2* c0qe = Memory::alloc<double2>(2 * (clast - cfirst));
+    Memory::ScratchScope scope;
+    double* c0area = Memory::scratch<double>(clast - cfirst);
+    double* c0evol = Memory::scratch<double>(clast - cfirst);
+    double* c0du = Memory::scratch<double>(clast - cfirst);
+    double* c0div = Memory::scratch<double>(clast - cfirst);
+    double* c0cos = Memory::scratch<double>(clast - cfirst);
+    double2ptr c0qe = Memory::scratch2(2 * (clast - cfirst));
 
     // [1] Find the right, left, top, bottom  edges to use for the
     //     limiters
@@ -57,6 +182,7 @@ void QCS::calcForce(
     // [2.3] Find the evolution factor c0evol(c) and the Delta u(c) = du(c)
     // [2.4] Find the weights c0w(c)
     setCornerDiv(c0area, c0div, c0evol, c0du, c0cos, sfirst, slast);
+    t0 = timer->lap(Timer::PH_QCSDIV, t0);
 
     // [3] Find the limiters Psi(c)
     // *** NOT IMPLEMENTED IN PENNANT ***
@@ -75,12 +201,7 @@ void QCS::calcForce(
     // [6] Set velocity difference to use to compute timestep
     setVelDiff(sfirst, slast);
 
-    Memory::free(c0area);
-    Memory::free(c0evol);
-    Memory::free(c0du);
-    Memory::free(c0div);
-    Memory::free(c0cos);
-    Memory::free(c0qe);
+    timer->lap(Timer::PH_QCSF, t0);
 }
 
 
@@ -98,56 +219,163 @@ void QCS::setCornerDiv(
             const int sfirst,
             const int slast) {
 
+    const Mesh* mesh = hydro->mesh;
+    const SetCornerDivOp op = { this, c0area, c0div, c0evol, c0du, c0cos,
+            sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename SM>
+void QCS::setCornerDiv(
+            const SM sm,
+            double* c0area,
+            double* c0div,
+            double* c0evol,
+            double* c0du,
+            double* c0cos,
+            const int sfirst,
+            const int slast) {
+
     const Mesh* mesh = hydro->mesh;
     const int nums = mesh->nums;
     const int numz = mesh->numz;
 
-    const double2* pu = hydro->pu;
-    const double2* px = mesh->pxp;
-    const double2* ex = mesh->exp;
-    const double2* zx = mesh->zxp;
+    const_double2ptr pu = hydro->pu;
+    const_double2ptr px = mesh->pxp;
+    const_double2ptr ex = mesh->exp;
+    const_double2ptr zx = mesh->zxp;
     const double* elen = mesh->elen;
-    const int* znump = mesh->znump;
 
     int cfirst = sfirst;
     int clast = slast;
-    int zfirst = mesh->mapsz[sfirst];
-    int zlast = (slast < nums ? mesh->mapsz[slast] : numz);
+    int zfirst = sm.zone(sfirst);
+    int zlast = (slast < nums ? sm.zone(slast) : numz);
 
-    double2* z0uc = Memory::alloc<double2>(zlast - zfirst);
-    double2 up0, up1, up2, up3;
-    double2 xp0, xp1, xp2, xp3;
+    Memory::ScratchScope scope;
+    double2ptr z0uc = Memory::scratch2(zlast - zfirst);
 
     // [1] Compute a zone-centered velocity
-    fill(&z0uc[0], &z0uc[zlast-zfirst], double2(0., 0.));
+    calcZoneVel<FieldsOne>(sm, pu, z0uc, sfirst, slast, zfirst, zlast);
+
+    // [2] Divergence at the corner
+    double* simdout[5] = { c0area, c0div, c0evol, c0du, c0cos };
+    if (simd != QCSSimd::NONE) {
+        QCSSimd::CornerDivArgs a;
+        a.mapsz = mesh->mapsz;
+        a.mapsp1 = mesh->mapsp1;
+        a.mapsp2 = mesh->mapsp2;
+        a.mapse = mesh->mapse;
+        a.mapss3 = mesh->mapss3;
+        a.pu = vec2In(pu);
+        a.px = vec2In(px);
+        a.ex = vec2In(ex);
+        a.zx = vec2In(zx);
+        a.z0uc = vec2In(z0uc);
+        a.elen = elen;
+        a.c0area = c0area;
+        a.c0div = c0div;
+        a.c0evol = c0evol;
+        a.c0du = c0du;
+        a.c0cos = c0cos;
+        a.cfirst = cfirst;
+        a.clast = clast;
+        a.zfirst = zfirst;
+        QCSSimd::cornerDiv(simd, a);
+        if (simdtol == 0.) return;
+        // compute scalar results separately, to check against
+        c0area = Memory::scratch<double>(clast - cfirst);
+        c0div = Memory::scratch<double>(clast - cfirst);
+        c0evol = Memory::scratch<double>(clast - cfirst);
+        c0du = Memory::scratch<double>(clast - cfirst);
+        c0cos = Memory::scratch<double>(clast - cfirst);
+    }
+
+    calcCornerDiv<FieldsOne>(sm, pu, px, ex, zx, z0uc, elen,
+            c0area, c0div, c0evol, c0du, c0cos, sfirst, slast, zfirst);
+
+    if (simd != QCSSimd::NONE) {
+        double* scalarout[5] = { c0area, c0div, c0evol, c0du, c0cos };
+        for (int i = 0; i < 5; ++i)
+            checkSimd(simdout[i], scalarout[i], clast - cfirst);
+    }
+}
+
+
+template <typename FT, typename SM>
+void QCS::calcZoneVel(
+        const SM sm,
+        typename FT::cptr2 pu,
+        typename FT::ptr2 z0uc,
+        const int sfirst,
+        const int slast,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real2 real2;
+
+    int cfirst = sfirst;
+    int clast = slast;
+
+    for (int z = 0; z < zlast - zfirst; ++z)
+        z0uc[z] = real2(0., 0.);
     for (int c = cfirst; c < clast; ++c) {
-        int p = mesh->mapsp1[c];
-        int z = mesh->mapsz[c];
+        int p = sm.p1(c);
+        int z = sm.zone(c);
         int z0 = z - zfirst;
         z0uc[z0] += pu[p];
     }
 
     for (int z = zfirst; z < zlast; ++z) {
         int z0 = z - zfirst;
-        z0uc[z0] /= (double) znump[z];
+        z0uc[z0] /= (double) sm.size(z);
     }
+}
+
+
+template <typename FT, typename SM>
+void QCS::calcCornerDiv(
+        const SM sm,
+        typename FT::cptr2 pu,
+        typename FT::cptr2 px,
+        typename FT::cptr2 ex,
+        typename FT::cptr2 zx,
+        typename FT::cptr2 z0uc,
+        typename FT::cptr elen,
+        typename FT::ptr c0area,
+        typename FT::ptr c0div,
+        typename FT::ptr c0evol,
+        typename FT::ptr c0du,
+        typename FT::ptr c0cos,
+        const int sfirst,
+        const int slast,
+        const int zfirst) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    int cfirst = sfirst;
+    int clast = slast;
+
+    real2 up0, up1, up2, up3;
+    real2 xp0, xp1, xp2, xp3;
 
-    // [2] Divergence at the corner
     #pragma ivdep
     for (int c = cfirst; c < clast; ++c) {
         int s2 = c;
-        int s = mesh->mapss3[s2];
+        int s = sm.prev(s2);
         // Associated zone, corner, point
-        int z = mesh->mapsz[s];
+        int z = sm.zone(s);
         int z0 = z - zfirst;
         int c0 = c - cfirst;
-        int p = mesh->mapsp2[s];
+        int p = sm.p2(s);
         // Points
-        int p1 = mesh->mapsp1[s];
-        int p2 = mesh->mapsp2[s2];
+        int p1 = sm.p1(s);
+        int p2 = sm.p2(s2);
         // Edges
-        int e1 = mesh->mapse[s];
-        int e2 = mesh->mapse[s2];
+        int e1 = sm.edge(s);
+        int e2 = sm.edge(s2);
 
         // Velocities and positions
         // 0 = point p
@@ -164,17 +392,17 @@ void QCS::setCornerDiv(
         xp3 = ex[e1];
 
         // compute 2d cartesian volume of corner
-        double cvolume = 0.5 * cross(xp2 - xp0, xp3 - xp1);
+        real cvolume = 0.5 * cross(xp2 - xp0, xp3 - xp1);
         c0area[c0] = cvolume;
 
         // compute cosine angle
-        double2 v1 = xp3 - xp0;
-        double2 v2 = xp1 - xp0;
-        double de1 = elen[e1];
-        double de2 = elen[e2];
-        double minelen = min(de1, de2);
-        c0cos[c0] = ((minelen < 1.e-12) ?
-                0. :
+        real2 v1 = xp3 - xp0;
+        real2 v2 = xp1 - xp0;
+        real de1 = elen[e1];
+        real de2 = elen[e2];
+        real minelen = min(de1, de2);
+        c0cos[c0] = select(minelen < 1.e-12,
+                0.,
                 4. * dot(v1, v2) / (de1 * de2));
 
         // compute divergence of corner
@@ -183,32 +411,30 @@ void QCS::setCornerDiv(
                 (2.0 * cvolume);
 
         // compute evolution factor
-        double2 dxx1 = 0.5 * (xp1 + xp2 - xp0 - xp3);
-        double2 dxx2 = 0.5 * (xp2 + xp3 - xp0 - xp1);
-        double dx1 = length(dxx1);
-        double dx2 = length(dxx2);
+        real2 dxx1 = 0.5 * (xp1 + xp2 - xp0 - xp3);
+        real2 dxx2 = 0.5 * (xp2 + xp3 - xp0 - xp1);
+        real dx1 = length(dxx1);
+        real dx2 = length(dxx2);
 
         // average corner-centered velocity
-        double2 duav = 0.25 * (up0 + up1 + up2 + up3);
-
-        double test1 = abs(dot(dxx1, duav) * dx2);
-        double test2 = abs(dot(dxx2, duav) * dx1);
-        double num = (test1 > test2 ? dx1 : dx2);
-        double den = (test1 > test2 ? dx2 : dx1);
-        double r = num / den;
-        double evol = sqrt(4.0 * cvolume * r);
+        real2 duav = 0.25 * (up0 + up1 + up2 + up3);
+
+        real test1 = abs(dot(dxx1, duav) * dx2);
+        real test2 = abs(dot(dxx2, duav) * dx1);
+        real num = select(test1 > test2, dx1, dx2);
+        real den = select(test1 > test2, dx2, dx1);
+        real r = num / den;
+        real evol = sqrt(4.0 * cvolume * r);
         evol = min(evol, 2.0 * minelen);
 
         // compute delta velocity
-        double dv1 = length2(up1 + up2 - up0 - up3);
-        double dv2 = length2(up2 + up3 - up0 - up1);
-        double du = sqrt(max(dv1, dv2));
+        real dv1 = length2(up1 + up2 - up0 - up3);
+        real dv2 = length2(up2 + up3 - up0 - up1);
+        real du = sqrt(max(dv1, dv2));
 
-        c0evol[c0] = (c0div[c0] < 0.0 ? evol : 0.);
-        c0du[c0]   = (c0div[c0] < 0.0 ? du   : 0.);
+        c0evol[c0] = select(c0div[c0] < 0.0, evol, 0.);
+        c0du[c0]   = select(c0div[c0] < 0.0, du,   0.);
     }  // for s
-
-    Memory::free(z0uc);
 }
 
 
@@ -217,13 +443,31 @@ void QCS::setQCnForce(
         const double* c0div,
         const double* c0du,
         const double* c0evol,
-        double2* c0qe,
+        double2ptr c0qe,
         const int sfirst,
         const int slast) {
 
     const Mesh* mesh = hydro->mesh;
+    const SetQCnForceOp op = { this, c0div, c0du, c0evol, c0qe, sfirst,
+            slast };
+    dispatchSideMap(mesh, op);
+
+}
+
 
-    const double2* pu = hydro->pu;
+template <typename SM>
+void QCS::setQCnForce(
+        const SM sm,
+        const double* c0div,
+        const double* c0du,
+        const double* c0evol,
+        double2ptr c0qe,
+        const int sfirst,
+        const int slast) {
+
+    const Mesh* mesh = hydro->mesh;
+
+    const_double2ptr pu = hydro->pu;
     const double* zrp = hydro->zrp;
     const double* zss = hydro->zss;
     const double* elen = mesh->elen;
@@ -231,23 +475,90 @@ void QCS::setQCnForce(
     int cfirst = sfirst;
     int clast = slast;
 
-    double* c0rmu = Memory::alloc<double>(clast - cfirst);
+    Memory::ScratchScope scope;
+
+    double2ptr simdqe = c0qe;
+    if (simdforce) {
+        QCSSimd::QCnForceArgs a;
+        a.mapsz = mesh->mapsz;
+        a.mapsp1 = mesh->mapsp1;
+        a.mapsp2 = mesh->mapsp2;
+        a.mapse = mesh->mapse;
+        a.mapss3 = mesh->mapss3;
+        a.pu = vec2In(pu);
+        a.zrp = zrp;
+        a.zss = zss;
+        a.elen = elen;
+        a.c0div = c0div;
+        a.c0du = c0du;
+        a.c0evol = c0evol;
+        QCSSimd::Vec2In qe = vec2In(c0qe);
+        a.c0qex = const_cast<double*>(qe.x);
+        a.c0qey = const_cast<double*>(qe.y);
+        a.qestride = qe.stride;
+        a.q1 = q1;
+        a.q2 = q2;
+        a.gammap1 = qgamma + 1.0;
+        a.cfirst = cfirst;
+        a.clast = clast;
+        QCSSimd::qcnForce(simd, a);
+        if (simdtol == 0.) return;
+        // compute scalar results separately, to check against
+        c0qe = Memory::scratch2(2 * (clast - cfirst));
+    }
+
+    calcQCnForce<FieldsOne>(sm, qgamma, q1, q2, pu, zrp, zss, elen,
+            c0div, c0du, c0evol, c0qe, sfirst, slast);
+
+    if (simdforce) {
+        QCSSimd::Vec2In vs = vec2In(simdqe);
+        QCSSimd::Vec2In vc = vec2In(c0qe);
+        checkSimd(vs.x, vc.x, 2 * (clast - cfirst), vs.stride);
+        checkSimd(vs.y, vc.y, 2 * (clast - cfirst), vs.stride);
+    }
+}
+
+
+template <typename FT, typename SM>
+void QCS::calcQCnForce(
+        const SM sm,
+        const typename FT::real qgamma,
+        const typename FT::real q1,
+        const typename FT::real q2,
+        typename FT::cptr2 pu,
+        typename FT::cptr zrp,
+        typename FT::cptr zss,
+        typename FT::cptr elen,
+        typename FT::cptr c0div,
+        typename FT::cptr c0du,
+        typename FT::cptr c0evol,
+        typename FT::ptr2 c0qe,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
+
+    int cfirst = sfirst;
+    int clast = slast;
+
+    Memory::ScratchScope scope;
+    typename FT::ptr c0rmu = FT::scratch(clast - cfirst);
 
-    const double gammap1 = qgamma + 1.0;
+    const real gammap1 = qgamma + 1.0;
 
     // [4.1] Compute the c0rmu (real Kurapatenko viscous scalar)
     #pragma ivdep
     for (int c = cfirst; c < clast; ++c) {
         int c0 = c - cfirst;
-        int z = mesh->mapsz[c];
+        int z = sm.zone(c);
 
         // Kurapatenko form of the viscosity
-        double ztmp2 = q2 * 0.25 * gammap1 * c0du[c0];
-        double ztmp1 = q1 * zss[z];
-        double zkur = ztmp2 + sqrt(ztmp2 * ztmp2 + ztmp1 * ztmp1);
+        real ztmp2 = q2 * 0.25 * gammap1 * c0du[c0];
+        real ztmp1 = q1 * zss[z];
+        real zkur = ztmp2 + sqrt(ztmp2 * ztmp2 + ztmp1 * ztmp1);
         // Compute c0rmu for each corner
-        double rmu = zkur * zrp[z] * c0evol[c0];
-        c0rmu[c0] = ((c0div[c0] > 0.0) ? 0. : rmu);
+        real rmu = zkur * zrp[z] * c0evol[c0];
+        c0rmu[c0] = select(c0div[c0] > 0.0, 0., rmu);
 
     } // for c
 
@@ -255,15 +566,15 @@ void QCS::setQCnForce(
     #pragma ivdep
     for (int c = cfirst; c < clast; ++c) {
         int s4 = c;
-        int s = mesh->mapss3[s4];
+        int s = sm.prev(s4);
         int c0 = c - cfirst;
-        int p = mesh->mapsp2[s];
+        int p = sm.p2(s);
         // Associated point and edge 1
-        int p1 = mesh->mapsp1[s];
-        int e1 = mesh->mapse[s];
+        int p1 = sm.p1(s);
+        int e1 = sm.edge(s);
         // Associated point and edge 2
-        int p2 = mesh->mapsp2[s4];
-        int e2 = mesh->mapse[s4];
+        int p2 = sm.p2(s4);
+        int e2 = sm.edge(s4);
 
         // Compute: c0qe(1,2,3)=edge 1, y component (2nd), 3rd corner
         //          c0qe(2,1,3)=edge 2, x component (1st)
@@ -271,35 +582,52 @@ void QCS::setQCnForce(
         c0qe[2 * c0 + 1] = c0rmu[c0] * (pu[p2] - pu[p]) / elen[e2];
 
     } // for s
-
-    Memory::free(c0rmu);
 }
 
 
 // Routine number [5]  in the full algorithm CS2DQforce(...)
 void QCS::setForce(
         const double* c0area,
-        const double2* c0qe,
+        const_double2ptr c0qe,
         double* c0cos,
-        double2* sfq,
+        double2ptr sfq,
         const int sfirst,
         const int slast) {
 
     const Mesh* mesh = hydro->mesh;
     const double* elen = mesh->elen;
+    const SetForceOp op = { elen, c0area, c0qe, c0cos, sfq, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void QCS::setForce(
+        const SM sm,
+        typename FT::cptr elen,
+        typename FT::cptr c0area,
+        typename FT::cptr2 c0qe,
+        typename FT::ptr c0cos,
+        typename FT::ptr2 sfq,
+        const int sfirst,
+        const int slast) {
+
+    typedef typename FT::real real;
 
     int cfirst = sfirst;
     int clast = slast;
 
-    double* c0w = Memory::alloc<double>(clast - cfirst);
+    Memory::ScratchScope scope;
+    typename FT::ptr c0w = FT::scratch(clast - cfirst);
 
     // [5.1] Preparation of extra variables
     #pragma ivdep
     for (int c = cfirst; c < clast; ++c) {
         int c0 = c - cfirst;
-        double csin2 = 1.0 - c0cos[c0] * c0cos[c0];
-        c0w[c0]   = ((csin2 < 1.e-4) ? 0. : c0area[c0] / csin2);
-        c0cos[c0] = ((csin2 < 1.e-4) ? 0. : c0cos[c0]);
+        real csin2 = 1.0 - c0cos[c0] * c0cos[c0];
+        c0w[c0]   = select(csin2 < 1.e-4, 0., c0area[c0] / csin2);
+        c0cos[c0] = select(csin2 < 1.e-4, 0., c0cos[c0]);
     } // for c
 
     // [5.2] Set-Up the forces on corners
@@ -308,19 +636,17 @@ void QCS::setForce(
         // Associated corners 1 and 2, and edge
         int c1 = s;
         int c10 = c1 - cfirst;
-        int c2 = mesh->mapss4[s];
+        int c2 = sm.next(s);
         int c20 = c2 - cfirst;
-        int e = mesh->mapse[s];
+        int e = sm.edge(s);
         // Edge length for c1, c2 contribution to s
-        double el = elen[e];
+        real el = elen[e];
 
         sfq[s] = (c0w[c10] * (c0qe[2*c10+1] + c0cos[c10] * c0qe[2*c10]) +
                   c0w[c20] * (c0qe[2*c20] + c0cos[c20] * c0qe[2*c20+1]))
             / el;
 
     } // for s
-
-    Memory::free(c0w);
 }
 
 
@@ -334,27 +660,53 @@ void QCS::setVelDiff(
     const int numz = mesh->numz;
     int zfirst = mesh->mapsz[sfirst];
     int zlast = (slast < nums ? mesh->mapsz[slast] : numz);
-    const double2* px = mesh->pxp;
-    const double2* pu = hydro->pu;
+    const_double2ptr px = mesh->pxp;
+    const_double2ptr pu = hydro->pu;
     const double* zss = hydro->zss;
     double* zdu = hydro->zdu;
     const double* elen = mesh->elen;
 
-    double* z0tmp = Memory::alloc<double>(zlast - zfirst);
+    const SetVelDiffOp op = { q1, q2, px, pu, zss, elen, zdu, sfirst, slast,
+            zfirst, zlast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void QCS::setVelDiff(
+        const SM sm,
+        const typename FT::real q1,
+        const typename FT::real q2,
+        typename FT::cptr2 px,
+        typename FT::cptr2 pu,
+        typename FT::cptr zss,
+        typename FT::cptr elen,
+        typename FT::ptr zdu,
+        const int sfirst,
+        const int slast,
+        const int zfirst,
+        const int zlast) {
+
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
+    Memory::ScratchScope scope;
+    typename FT::ptr z0tmp = FT::scratch(zlast - zfirst);
 
-    fill(&z0tmp[0], &z0tmp[zlast-zfirst], 0.);
+    fill(&z0tmp[0], &z0tmp[zlast-zfirst], real(0.));
     for (int s = sfirst; s < slast; ++s) {
-        int p1 = mesh->mapsp1[s];
-        int p2 = mesh->mapsp2[s];
-        int z = mesh->mapsz[s];
-        int e = mesh->mapse[s];
+        int p1 = sm.p1(s);
+        int p2 = sm.p2(s);
+        int z = sm.zone(s);
+        int e = sm.edge(s);
         int z0 = z - zfirst;
 
-        double2 dx = px[p2] - px[p1];
-        double2 du = pu[p2] - pu[p1];
-        double lenx = elen[e];
-        double dux = dot(du, dx);
-        dux = (lenx > 0. ? abs(dux) / lenx : 0.);
+        real2 dx = px[p2] - px[p1];
+        real2 du = pu[p2] - pu[p1];
+        real lenx = elen[e];
+        real dux = dot(du, dx);
+        dux = select(lenx > 0., abs(dux) / lenx, 0.);
 
         z0tmp[z0] = max(z0tmp[z0], dux);
     }
@@ -363,7 +715,69 @@ void QCS::setVelDiff(
         int z0 = z - zfirst;
         zdu[z] = q1 * zss[z] + 2. * q2 * z0tmp[z0];
     }
+}
+
+
+
+void QCS::checkSimd(
+        const double* vsimd,
+        const double* vscalar,
+        const int n,
+        const int stride) {
+
+    double maxdiff = 0.;
+    for (int i = 0; i < n; ++i) {
+        double a = vsimd[i * stride];
+        double b = vscalar[i * stride];
+        if (a == b || (a != a && b != b)) continue;
+        double diff = abs(a - b) / max(abs(a), abs(b));
+        // NaN in only one of them counts as a failure
+        if (diff != diff) diff = 1.e99;
+        maxdiff = max(maxdiff, diff);
+    }
+    #pragma omp critical
+    simdmaxdiff = max(simdmaxdiff, maxdiff);
 
-    Memory::free(z0tmp);
 }
 
+
+void QCS::writeSimdCheck() {
+
+    using Parallel::mype;
+
+    if (simd == QCSSimd::NONE || simdtol == 0.) return;
+
+    double maxdiff = simdmaxdiff;
+    Parallel::globalMax(maxdiff);
+    bool ok = (maxdiff <= simdtol);
+    if (mype == 0) {
+        cout << endl;
+        cout << "QCS SIMD check (" << QCSSimd::isaName(simd) << "):  "
+             << "max relative difference = " << scientific
+             << setprecision(6) << maxdiff
+             << (ok ? ", passed" : ", FAILED") << endl;
+    }
+    if (!ok) exit(1);
+
+}
+
+
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES_SM(FT, SM) \
+    template void QCS::calcZoneVel<FT, SM>(const SM, FT::cptr2, \
+            FT::ptr2, const int, const int, const int, const int); \
+    template void QCS::calcCornerDiv<FT, SM>(const SM, FT::cptr2, \
+            FT::cptr2, FT::cptr2, FT::cptr2, FT::cptr2, FT::cptr, \
+            FT::ptr, FT::ptr, FT::ptr, FT::ptr, FT::ptr, const int, \
+            const int, const int); \
+    template void QCS::calcQCnForce<FT, SM>(const SM, const FT::real, \
+            const FT::real, const FT::real, FT::cptr2, FT::cptr, \
+            FT::cptr, FT::cptr, FT::cptr, FT::cptr, FT::cptr, FT::ptr2, \
+            const int, const int); \
+    template void QCS::setForce<FT, SM>(const SM, FT::cptr, FT::cptr, \
+            FT::cptr2, FT::ptr, FT::ptr2, const int, const int); \
+    template void QCS::setVelDiff<FT, SM>(const SM, const FT::real, \
+            const FT::real, FT::cptr2, FT::cptr2, FT::cptr, FT::cptr, \
+            FT::ptr, const int, const int, const int, const int);
+FOR_EACH_LANES_SM(INSTANTIATE_LANES_SM)
+#undef INSTANTIATE_LANES_SM
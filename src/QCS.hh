@@ -13,7 +13,9 @@
 #ifndef QCS_HH_
 #define QCS_HH_
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
+#include "QCSSimd.hh"
 
 // forward declarations
 class InputFile;
@@ -29,15 +31,30 @@ public:
     double qgamma;                 // gamma coefficient for Q model
     double q1, q2;                 // linear and quadratic coefficients
                                    // for Q model
+    QCSSimd::ISA simd;             // instruction set for SIMD loops,
+                                   // or NONE for scalar loops
+    bool simdforce;                // use SIMD for Q vector loop also?
+    double simdtol;                // if nonzero, also run the scalar
+                                   // loops and check SIMD results
+                                   // against them to this tolerance
+    double simdmaxdiff;            // largest relative difference
+                                   // found by the check
 
     QCS(const InputFile* inp, Hydro* h);
     ~QCS();
 
     void calcForce(
-            double2* sf,
+            double2ptr sf,
             const int sfirst,
             const int slast);
 
+    // the steps of calcForce below have a plain version for this
+    // problem, which uses SIMD loops if selected, and otherwise
+    // the static versions templated on field types (see
+    // FieldTypes.hh) and a side map (see SideMap.hh), with
+    // FieldsOne; HydroLanes calls the templated versions for its
+    // lanes
+
     void setCornerDiv(
             double* c0area,
             double* c0div,
@@ -46,26 +63,122 @@ public:
             double* c0cos,
             const int sfirst,
             const int slast);
+    template <typename SM>
+    void setCornerDiv(
+            const SM sm,
+            double* c0area,
+            double* c0div,
+            double* c0evol,
+            double* c0du,
+            double* c0cos,
+            const int sfirst,
+            const int slast);
+    // zone-centered velocity, for setCornerDiv
+    template <typename FT, typename SM>
+    static void calcZoneVel(
+            const SM sm,
+            typename FT::cptr2 pu,
+            typename FT::ptr2 z0uc,
+            const int sfirst,
+            const int slast,
+            const int zfirst,
+            const int zlast);
+    template <typename FT, typename SM>
+    static void calcCornerDiv(
+            const SM sm,
+            typename FT::cptr2 pu,
+            typename FT::cptr2 px,
+            typename FT::cptr2 ex,
+            typename FT::cptr2 zx,
+            typename FT::cptr2 z0uc,
+            typename FT::cptr elen,
+            typename FT::ptr c0area,
+            typename FT::ptr c0div,
+            typename FT::ptr c0evol,
+            typename FT::ptr c0du,
+            typename FT::ptr c0cos,
+            const int sfirst,
+            const int slast,
+            const int zfirst);
 
     void setQCnForce(
             const double* c0div,
             const double* c0du,
             const double* c0evol,
-            double2* c0qe,
+            double2ptr c0qe,
+            const int sfirst,
+            const int slast);
+    template <typename SM>
+    void setQCnForce(
+            const SM sm,
+            const double* c0div,
+            const double* c0du,
+            const double* c0evol,
+            double2ptr c0qe,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void calcQCnForce(
+            const SM sm,
+            const typename FT::real qgamma,
+            const typename FT::real q1,
+            const typename FT::real q2,
+            typename FT::cptr2 pu,
+            typename FT::cptr zrp,
+            typename FT::cptr zss,
+            typename FT::cptr elen,
+            typename FT::cptr c0div,
+            typename FT::cptr c0du,
+            typename FT::cptr c0evol,
+            typename FT::ptr2 c0qe,
             const int sfirst,
             const int slast);
 
     void setForce(
             const double* c0area,
-            const double2* c0qe,
+            const_double2ptr c0qe,
             double* c0cos,
-            double2* sfqq,
+            double2ptr sfqq,
+            const int sfirst,
+            const int slast);
+    template <typename FT, typename SM>
+    static void setForce(
+            const SM sm,
+            typename FT::cptr elen,
+            typename FT::cptr c0area,
+            typename FT::cptr2 c0qe,
+            typename FT::ptr c0cos,
+            typename FT::ptr2 sfqq,
             const int sfirst,
             const int slast);
 
     void setVelDiff(
             const int sfirst,
             const int slast);
+    template <typename FT, typename SM>
+    static void setVelDiff(
+            const SM sm,
+            const typename FT::real q1,
+            const typename FT::real q2,
+            typename FT::cptr2 px,
+            typename FT::cptr2 pu,
+            typename FT::cptr zss,
+            typename FT::cptr elen,
+            typename FT::ptr zdu,
+            const int sfirst,
+            const int slast,
+            const int zfirst,
+            const int zlast);
+
+    // update simdmaxdiff from SIMD and scalar results
+    void checkSimd(
+            const double* vsimd,
+            const double* vscalar,
+            const int n,
+            const int stride = 1);
+
+    // write SIMD check result; exits if it failed
+    void writeSimdCheck();
 
 };  // class QCS
 
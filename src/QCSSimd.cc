@@ -0,0 +1,90 @@
+/*
+ * QCSSimd.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "QCSSimd.hh"
+
+using namespace std;
+
+
+bool QCSSimd::parseISA(const string& name, ISA& isa) {
+
+    if (name == "none") isa = NONE;
+    else if (name == "sse2") isa = SSE2;
+    else if (name == "avx2") isa = AVX2;
+    else if (name == "avx512") isa = AVX512;
+    else if (name == "auto") {
+        if (supported(AVX512)) isa = AVX512;
+        else if (supported(AVX2)) isa = AVX2;
+        else if (supported(SSE2)) isa = SSE2;
+        else isa = NONE;
+    }
+    else return false;
+    return true;
+
+}
+
+
+const char* QCSSimd::isaName(const ISA isa) {
+
+    switch (isa) {
+    case SSE2:   return "sse2";
+    case AVX2:   return "avx2";
+    case AVX512: return "avx512";
+    default:     return "none";
+    }
+
+}
+
+
+bool QCSSimd::supported(const ISA isa) {
+
+    if (isa == NONE) return true;
+#ifdef QCS_SIMD_X86
+    __builtin_cpu_init();
+    switch (isa) {
+    case SSE2:   return __builtin_cpu_supports("sse2");
+    case AVX2:   return __builtin_cpu_supports("avx2");
+    case AVX512: return __builtin_cpu_supports("avx512f");
+    default:     return false;
+    }
+#else
+    return false;
+#endif
+
+}
+
+
+void QCSSimd::cornerDiv(const ISA isa, const CornerDivArgs& a) {
+
+#ifdef QCS_SIMD_X86
+    switch (isa) {
+    case SSE2:   cornerDivSSE2(a); break;
+    case AVX2:   cornerDivAVX2(a); break;
+    case AVX512: cornerDivAVX512(a); break;
+    default:     break;
+    }
+#endif
+
+}
+
+
+void QCSSimd::qcnForce(const ISA isa, const QCnForceArgs& a) {
+
+#ifdef QCS_SIMD_X86
+    switch (isa) {
+    case SSE2:   qcnForceSSE2(a); break;
+    case AVX2:   qcnForceAVX2(a); break;
+    case AVX512: qcnForceAVX512(a); break;
+    default:     break;
+    }
+#endif
+
+}
@@ -0,0 +1,96 @@
+/*
+ * QCSSimd.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef QCSSIMD_HH_
+#define QCSSIMD_HH_
+
+#include <string>
+
+// SIMD versions of the QCS corner loops are built for x86 with
+// GCC-compatible compilers; elsewhere only the scalar loops exist
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define QCS_SIMD_X86
+#endif
+
+
+// Namespace QCSSimd holds explicit SIMD versions of the per-corner
+// loops in QCS::setCornerDiv and QCS::setQCnForce.  Each instruction
+// set has its own translation unit (QCSSimdSSE2.cc, QCSSimdAVX2.cc,
+// QCSSimdAVX512.cc), compiled for that instruction set only, and the
+// one to use is chosen at run time from what the CPU supports.  The
+// arithmetic is done in the same order as in the scalar loops, with
+// no fused multiply-adds, so the results are the same.
+
+namespace QCSSimd {
+
+    enum ISA { NONE, SSE2, AVX2, AVX512 };
+
+    // a double2 array, as pointers to the x and y values of its
+    // first element and the distance between elements (2 if x and
+    // y are interleaved, 1 if stored separately)
+    struct Vec2In {
+        const double* x;
+        const double* y;
+        int stride;
+    };
+
+    // inputs and outputs for the corner divergence loop ([2] in
+    // QCS::setCornerDiv), for corners cfirst to clast-1
+    struct CornerDivArgs {
+        const int *mapsz, *mapsp1, *mapsp2, *mapse, *mapss3;
+        Vec2In pu, px, ex, zx;
+        Vec2In z0uc;               // zone velocities, from zone zfirst
+        const double* elen;
+        double *c0area, *c0div, *c0evol, *c0du, *c0cos;
+        int cfirst, clast, zfirst;
+    };
+
+    // inputs and outputs for the Q vector loops ([4.1] and [4.2] in
+    // QCS::setQCnForce); c0qe is written to c0qex and c0qey, in
+    // the same layout as c0qe itself
+    struct QCnForceArgs {
+        const int *mapsz, *mapsp1, *mapsp2, *mapse, *mapss3;
+        Vec2In pu;
+        const double *zrp, *zss, *elen;
+        const double *c0div, *c0du, *c0evol;
+        double *c0qex, *c0qey;
+        int qestride;
+        double q1, q2, gammap1;
+        int cfirst, clast;
+    };
+
+    // instruction set from name ("none", "sse2", "avx2", "avx512",
+    // or "auto" for the best one this CPU supports); returns false
+    // if the name is unknown
+    bool parseISA(const std::string& name, ISA& isa);
+
+    const char* isaName(const ISA isa);
+
+    // can this build and CPU run isa?
+    bool supported(const ISA isa);
+
+    // run the loops with the given instruction set, which must
+    // be supported
+    void cornerDiv(const ISA isa, const CornerDivArgs& a);
+    void qcnForce(const ISA isa, const QCnForceArgs& a);
+
+    // per-instruction-set versions, defined in their own files
+    void cornerDivSSE2(const CornerDivArgs& a);
+    void cornerDivAVX2(const CornerDivArgs& a);
+    void cornerDivAVX512(const CornerDivArgs& a);
+    void qcnForceSSE2(const QCnForceArgs& a);
+    void qcnForceAVX2(const QCnForceArgs& a);
+    void qcnForceAVX512(const QCnForceArgs& a);
+
+}  // namespace QCSSimd
+
+
+#endif /* QCSSIMD_HH_ */
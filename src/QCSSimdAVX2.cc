@@ -0,0 +1,80 @@
+/*
+ * QCSSimdAVX2.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "QCSSimd.hh"
+
+#ifdef QCS_SIMD_X86
+
+#include <immintrin.h>
+
+// compile this file's loops for AVX2 only, without fused
+// multiply-adds, so results match the scalar loops
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+
+#include "QCSSimdImpl.hh"
+
+namespace {
+
+struct SimdAVX2 {
+    enum { W = 4 };
+    typedef __m256d V;
+    typedef __m256d M;
+
+    static inline V set1(const double x) { return _mm256_set1_pd(x); }
+    static inline V load(const double* p) { return _mm256_loadu_pd(p); }
+    static inline void store(double* p, const V v) {
+        _mm256_storeu_pd(p, v);
+    }
+    static inline V gather(const double* p, const int* idx) {
+        // the masked form with a zeroed source keeps GCC from
+        // warning that the unmasked form's source is uninitialized
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p,
+                _mm_loadu_si128((const __m128i*) idx),
+                _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+    }
+
+    static inline V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm256_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm256_sqrt_pd(a); }
+    static inline V abs(const V a) {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.), a);
+    }
+    // operands swapped to match std::min, std::max
+    static inline V min(const V a, const V b) { return _mm256_min_pd(b, a); }
+    static inline V max(const V a, const V b) { return _mm256_max_pd(b, a); }
+
+    static inline M lt(const V a, const V b) {
+        return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+    }
+    static inline M gt(const V a, const V b) {
+        return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+    }
+    static inline V select(const M m, const V a, const V b) {
+        return _mm256_blendv_pd(b, a, m);
+    }
+};
+
+}  // namespace
+
+
+void QCSSimd::cornerDivAVX2(const CornerDivArgs& a) {
+    cornerDivImpl<SimdAVX2>(a);
+}
+
+
+void QCSSimd::qcnForceAVX2(const QCnForceArgs& a) {
+    qcnForceImpl<SimdAVX2>(a);
+}
+
+#endif  // QCS_SIMD_X86
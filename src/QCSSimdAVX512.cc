@@ -0,0 +1,83 @@
+/*
+ * QCSSimdAVX512.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "QCSSimd.hh"
+
+#ifdef QCS_SIMD_X86
+
+// some GCC versions warn falsely about the undefined vectors
+// used inside the AVX-512 intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <immintrin.h>
+
+// compile this file's loops for AVX-512 only, without fused
+// multiply-adds, so results match the scalar loops
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+
+#include "QCSSimdImpl.hh"
+
+namespace {
+
+struct SimdAVX512 {
+    enum { W = 8 };
+    typedef __m512d V;
+    typedef __mmask8 M;
+
+    static inline V set1(const double x) { return _mm512_set1_pd(x); }
+    static inline V load(const double* p) { return _mm512_loadu_pd(p); }
+    static inline void store(double* p, const V v) {
+        _mm512_storeu_pd(p, v);
+    }
+    static inline V gather(const double* p, const int* idx) {
+        return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff,
+                _mm256_loadu_si256((const __m256i*) idx), p, 8);
+    }
+
+    static inline V add(const V a, const V b) { return _mm512_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm512_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm512_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm512_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm512_sqrt_pd(a); }
+    static inline V abs(const V a) {
+        return _mm512_castsi512_pd(_mm512_andnot_si512(
+                _mm512_castpd_si512(_mm512_set1_pd(-0.)),
+                _mm512_castpd_si512(a)));
+    }
+    // operands swapped to match std::min, std::max
+    static inline V min(const V a, const V b) { return _mm512_min_pd(b, a); }
+    static inline V max(const V a, const V b) { return _mm512_max_pd(b, a); }
+
+    static inline M lt(const V a, const V b) {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+    }
+    static inline M gt(const V a, const V b) {
+        return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+    }
+    static inline V select(const M m, const V a, const V b) {
+        return _mm512_mask_blend_pd(m, b, a);
+    }
+};
+
+}  // namespace
+
+
+void QCSSimd::cornerDivAVX512(const CornerDivArgs& a) {
+    cornerDivImpl<SimdAVX512>(a);
+}
+
+
+void QCSSimd::qcnForceAVX512(const QCnForceArgs& a) {
+    qcnForceImpl<SimdAVX512>(a);
+}
+
+#endif  // QCS_SIMD_X86
@@ -0,0 +1,290 @@
+/*
+ * QCSSimdImpl.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef QCSSIMDIMPL_HH_
+#define QCSSIMDIMPL_HH_
+
+// SIMD loops for QCS, written once for any instruction set.  This
+// file is included only by the per-instruction-set files, each of
+// which defines a class S with:
+//     W                   number of doubles in a vector
+//     V                   vector of W doubles
+//     M                   result of a comparison
+//     set1(x)             all lanes set to x
+//     load(p), store(p, v)   W contiguous doubles
+//     gather(p, idx)      p[idx[0]], ..., p[idx[W-1]]
+//     add, sub, mul, div, sqrt, abs
+//     min(a, b), max(a, b)   same results as std::min, std::max
+//     lt(a, b), gt(a, b)  comparisons
+//     select(m, a, b)     m ? a : b in each lane
+// The expressions below follow the scalar loops in QCS.cc term for
+// term, so that each lane gets exactly the scalar result.
+
+#include "QCSSimd.hh"
+
+namespace QCSSimd {
+
+// a vector of double2 values, one per lane
+template <typename S>
+struct Vec2V {
+    typename S::V x, y;
+};
+
+template <typename S>
+inline Vec2V<S> gather2(const Vec2In& a, const int* idx) {
+    int sidx[S::W];
+    for (int i = 0; i < S::W; ++i)
+        sidx[i] = idx[i] * a.stride;
+    Vec2V<S> r;
+    r.x = S::gather(a.x, sidx);
+    r.y = S::gather(a.y, sidx);
+    return r;
+}
+
+template <typename S>
+inline Vec2V<S> add2(const Vec2V<S>& a, const Vec2V<S>& b) {
+    Vec2V<S> r;
+    r.x = S::add(a.x, b.x);
+    r.y = S::add(a.y, b.y);
+    return r;
+}
+
+template <typename S>
+inline Vec2V<S> sub2(const Vec2V<S>& a, const Vec2V<S>& b) {
+    Vec2V<S> r;
+    r.x = S::sub(a.x, b.x);
+    r.y = S::sub(a.y, b.y);
+    return r;
+}
+
+// scalar times vector, as in operator*(double, double2)
+template <typename S>
+inline Vec2V<S> scale2(const typename S::V& r, const Vec2V<S>& a) {
+    Vec2V<S> v;
+    v.x = S::mul(a.x, r);
+    v.y = S::mul(a.y, r);
+    return v;
+}
+
+template <typename S>
+inline typename S::V dot2(const Vec2V<S>& a, const Vec2V<S>& b) {
+    return S::add(S::mul(a.x, b.x), S::mul(a.y, b.y));
+}
+
+template <typename S>
+inline typename S::V cross2(const Vec2V<S>& a, const Vec2V<S>& b) {
+    return S::sub(S::mul(a.x, b.y), S::mul(a.y, b.x));
+}
+
+// store the first n lanes of v
+template <typename S>
+inline void storeN(double* p, const typename S::V& v, const int n) {
+    if (n == S::W) {
+        S::store(p, v);
+        return;
+    }
+    double tmp[S::W];
+    S::store(tmp, v);
+    for (int i = 0; i < n; ++i)
+        p[i] = tmp[i];
+}
+
+
+template <typename S>
+void cornerDivImpl(const CornerDivArgs& a) {
+
+    typedef typename S::V V;
+    typedef typename S::M M;
+    typedef Vec2V<S> V2;
+    const int W = S::W;
+
+    const V zero = S::set1(0.);
+    const V half = S::set1(0.5);
+    const V quarter = S::set1(0.25);
+    const V two = S::set1(2.0);
+    const V four = S::set1(4.0);
+    const V tiny = S::set1(1.e-12);
+
+    int ip[W], ip1[W], ip2[W], ie1[W], ie2[W], iz[W], iz0[W];
+    for (int cv = a.cfirst; cv < a.clast; cv += W) {
+        const int n = (a.clast - cv < W ? a.clast - cv : W);
+
+        // look up mesh indices; unused lanes repeat the last corner
+        for (int i = 0; i < W; ++i) {
+            int s2 = cv + (i < n ? i : n - 1);
+            int s = a.mapss3[s2];
+            iz[i] = a.mapsz[s];
+            iz0[i] = iz[i] - a.zfirst;
+            ip[i] = a.mapsp2[s];
+            ip1[i] = a.mapsp1[s];
+            ip2[i] = a.mapsp2[s2];
+            ie1[i] = a.mapse[s];
+            ie2[i] = a.mapse[s2];
+        }
+
+        // velocities and positions, as in the scalar loop
+        const V2 pup = gather2<S>(a.pu, ip);
+        const V2 pup1 = gather2<S>(a.pu, ip1);
+        const V2 pup2 = gather2<S>(a.pu, ip2);
+        const V2 up0 = pup;
+        const V2 xp0 = gather2<S>(a.px, ip);
+        const V2 up1 = scale2<S>(half, add2<S>(pup, pup2));
+        const V2 xp1 = gather2<S>(a.ex, ie2);
+        const V2 up2 = gather2<S>(a.z0uc, iz0);
+        const V2 xp2 = gather2<S>(a.zx, iz);
+        const V2 up3 = scale2<S>(half, add2<S>(pup1, pup));
+        const V2 xp3 = gather2<S>(a.ex, ie1);
+
+        // corner volume
+        const V cvolume = S::mul(half,
+                cross2<S>(sub2<S>(xp2, xp0), sub2<S>(xp3, xp1)));
+
+        // cosine angle
+        const V2 v1 = sub2<S>(xp3, xp0);
+        const V2 v2 = sub2<S>(xp1, xp0);
+        const V de1 = S::gather(a.elen, ie1);
+        const V de2 = S::gather(a.elen, ie2);
+        const V minelen = S::min(de1, de2);
+        const V cosv = S::div(S::mul(four, dot2<S>(v1, v2)),
+                S::mul(de1, de2));
+        const V c0cos = S::select(S::lt(minelen, tiny), zero, cosv);
+
+        // divergence
+        const V c0div = S::div(
+                S::sub(cross2<S>(sub2<S>(up2, up0), sub2<S>(xp3, xp1)),
+                       cross2<S>(sub2<S>(up3, up1), sub2<S>(xp2, xp0))),
+                S::mul(two, cvolume));
+
+        // evolution factor
+        const V2 dxx1 = scale2<S>(half,
+                sub2<S>(sub2<S>(add2<S>(xp1, xp2), xp0), xp3));
+        const V2 dxx2 = scale2<S>(half,
+                sub2<S>(sub2<S>(add2<S>(xp2, xp3), xp0), xp1));
+        const V dx1 = S::sqrt(dot2<S>(dxx1, dxx1));
+        const V dx2 = S::sqrt(dot2<S>(dxx2, dxx2));
+
+        const V2 duav = scale2<S>(quarter,
+                add2<S>(add2<S>(add2<S>(up0, up1), up2), up3));
+
+        const V test1 = S::abs(S::mul(dot2<S>(dxx1, duav), dx2));
+        const V test2 = S::abs(S::mul(dot2<S>(dxx2, duav), dx1));
+        const M t12 = S::gt(test1, test2);
+        const V num = S::select(t12, dx1, dx2);
+        const V den = S::select(t12, dx2, dx1);
+        const V r = S::div(num, den);
+        V evol = S::sqrt(S::mul(S::mul(four, cvolume), r));
+        evol = S::min(evol, S::mul(two, minelen));
+
+        // delta velocity
+        const V2 dvv1 = sub2<S>(sub2<S>(add2<S>(up1, up2), up0), up3);
+        const V2 dvv2 = sub2<S>(sub2<S>(add2<S>(up2, up3), up0), up1);
+        const V dv1 = dot2<S>(dvv1, dvv1);
+        const V dv2 = dot2<S>(dvv2, dvv2);
+        const V du = S::sqrt(S::max(dv1, dv2));
+
+        const M neg = S::lt(c0div, zero);
+        const int c0 = cv - a.cfirst;
+        storeN<S>(&a.c0area[c0], cvolume, n);
+        storeN<S>(&a.c0cos[c0], c0cos, n);
+        storeN<S>(&a.c0div[c0], c0div, n);
+        storeN<S>(&a.c0evol[c0], S::select(neg, evol, zero), n);
+        storeN<S>(&a.c0du[c0], S::select(neg, du, zero), n);
+    }  // for cv
+
+}
+
+
+template <typename S>
+void qcnForceImpl(const QCnForceArgs& a) {
+
+    typedef typename S::V V;
+    typedef Vec2V<S> V2;
+    const int W = S::W;
+
+    const V zero = S::set1(0.);
+    const V one = S::set1(1.);
+    const V kq2 = S::set1(a.q2 * 0.25 * a.gammap1);
+    const V kq1 = S::set1(a.q1);
+
+    int iz[W], ip[W], ip1[W], ip2[W], ie1[W], ie2[W];
+    double qe1x[W], qe1y[W], qe2x[W], qe2y[W];
+    for (int cv = a.cfirst; cv < a.clast; cv += W) {
+        const int n = (a.clast - cv < W ? a.clast - cv : W);
+        const int c0 = cv - a.cfirst;
+
+        for (int i = 0; i < W; ++i) {
+            int s4 = cv + (i < n ? i : n - 1);
+            int s = a.mapss3[s4];
+            iz[i] = a.mapsz[s4];
+            ip[i] = a.mapsp2[s];
+            ip1[i] = a.mapsp1[s];
+            ie1[i] = a.mapse[s];
+            ip2[i] = a.mapsp2[s4];
+            ie2[i] = a.mapse[s4];
+        }
+
+        // [4.1] Kurapatenko viscous scalar
+        V du, evol, div;
+        if (n == W) {
+            du = S::load(&a.c0du[c0]);
+            evol = S::load(&a.c0evol[c0]);
+            div = S::load(&a.c0div[c0]);
+        }
+        else {
+            double tdu[W], tevol[W], tdiv[W];
+            for (int i = 0; i < W; ++i) {
+                int j = c0 + (i < n ? i : n - 1);
+                tdu[i] = a.c0du[j];
+                tevol[i] = a.c0evol[j];
+                tdiv[i] = a.c0div[j];
+            }
+            du = S::load(tdu);
+            evol = S::load(tevol);
+            div = S::load(tdiv);
+        }
+        const V ztmp2 = S::mul(kq2, du);
+        const V ztmp1 = S::mul(kq1, S::gather(a.zss, iz));
+        const V zkur = S::add(ztmp2, S::sqrt(
+                S::add(S::mul(ztmp2, ztmp2), S::mul(ztmp1, ztmp1))));
+        const V rmu = S::mul(S::mul(zkur, S::gather(a.zrp, iz)), evol);
+        const V c0rmu = S::select(S::gt(div, zero), zero, rmu);
+
+        // [4.2] Q vector on each edge of the corner
+        const V2 pup = gather2<S>(a.pu, ip);
+        const V2 pup1 = gather2<S>(a.pu, ip1);
+        const V2 pup2 = gather2<S>(a.pu, ip2);
+        const V rinv1 = S::div(one, S::gather(a.elen, ie1));
+        const V rinv2 = S::div(one, S::gather(a.elen, ie2));
+        const V2 qe1 = scale2<S>(rinv1,
+                scale2<S>(c0rmu, sub2<S>(pup, pup1)));
+        const V2 qe2 = scale2<S>(rinv2,
+                scale2<S>(c0rmu, sub2<S>(pup2, pup)));
+
+        S::store(qe1x, qe1.x);
+        S::store(qe1y, qe1.y);
+        S::store(qe2x, qe2.x);
+        S::store(qe2y, qe2.y);
+        for (int i = 0; i < n; ++i) {
+            int k1 = (2 * (c0 + i)) * a.qestride;
+            int k2 = (2 * (c0 + i) + 1) * a.qestride;
+            a.c0qex[k1] = qe1x[i];
+            a.c0qey[k1] = qe1y[i];
+            a.c0qex[k2] = qe2x[i];
+            a.c0qey[k2] = qe2y[i];
+        }
+    }  // for cv
+
+}
+
+}  // namespace QCSSimd
+
+
+#endif /* QCSSIMDIMPL_HH_ */
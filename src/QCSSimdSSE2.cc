@@ -0,0 +1,70 @@
+/*
+ * QCSSimdSSE2.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "QCSSimd.hh"
+
+#ifdef QCS_SIMD_X86
+
+#include <immintrin.h>
+
+// compile this file's loops for SSE2 only, without fused
+// multiply-adds, so results match the scalar loops
+#pragma GCC target("sse2")
+#pragma GCC optimize("fp-contract=off")
+
+#include "QCSSimdImpl.hh"
+
+namespace {
+
+struct SimdSSE2 {
+    enum { W = 2 };
+    typedef __m128d V;
+    typedef __m128d M;
+
+    static inline V set1(const double x) { return _mm_set1_pd(x); }
+    static inline V load(const double* p) { return _mm_loadu_pd(p); }
+    static inline void store(double* p, const V v) { _mm_storeu_pd(p, v); }
+    static inline V gather(const double* p, const int* idx) {
+        return _mm_set_pd(p[idx[1]], p[idx[0]]);
+    }
+
+    static inline V add(const V a, const V b) { return _mm_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm_sqrt_pd(a); }
+    static inline V abs(const V a) {
+        return _mm_andnot_pd(_mm_set1_pd(-0.), a);
+    }
+    // operands swapped to match std::min, std::max
+    static inline V min(const V a, const V b) { return _mm_min_pd(b, a); }
+    static inline V max(const V a, const V b) { return _mm_max_pd(b, a); }
+
+    static inline M lt(const V a, const V b) { return _mm_cmplt_pd(a, b); }
+    static inline M gt(const V a, const V b) { return _mm_cmpgt_pd(a, b); }
+    static inline V select(const M m, const V a, const V b) {
+        return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+    }
+};
+
+}  // namespace
+
+
+void QCSSimd::cornerDivSSE2(const CornerDivArgs& a) {
+    cornerDivImpl<SimdSSE2>(a);
+}
+
+
+void QCSSimd::qcnForceSSE2(const QCnForceArgs& a) {
+    qcnForceImpl<SimdSSE2>(a);
+}
+
+#endif  // QCS_SIMD_X86
@@ -0,0 +1,355 @@
+/*
+ * Roofline.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Roofline.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include "Parallel.hh"
+#include "Memory.hh"
+#include "InputFile.hh"
+#include "Mesh.hh"
+#include "SideMap.hh"
+#include "Hydro.hh"
+#include "QCS.hh"
+#include "Timer.hh"
+
+using namespace std;
+
+
+namespace {
+
+// function object for dispatchSideMap (see SideMap.hh):  finds
+// which maps the side map given reads
+struct MapsReadOp {
+    bool* zonemaps;
+    bool* pointmaps;
+
+    template <typename SM>
+    void operator()(const SM) const {
+        *zonemaps = SM::zonemaps;
+        *pointmaps = SM::pointmaps;
+    }
+};
+
+}  // namespace
+
+
+Roofline::Roofline(
+        const InputFile* inp,
+        const Mesh* m,
+        const Hydro* h) : mesh(m), hydro(h) {
+
+    using Parallel::mype;
+
+    streamsize = inp->getInt("streamsize", 1 << 23);
+    streamreps = inp->getInt("streamreps", 5);
+
+    calcModel();
+
+    streambw = probeBandwidth();
+    if (mype == 0) {
+        cout << "STREAM triad bandwidth:  " << scientific
+             << setprecision(4) << streambw * 1.e-9 << " GB/s"
+             << " (" << streamsize << " doubles/array)" << endl;
+    }
+
+}
+
+
+Roofline::~Roofline() {}
+
+
+void Roofline::calcModel() {
+
+    // Traffic is the compulsory minimum for each phase:  every
+    // array touched by the phase is counted once (read and/or
+    // written), regardless of how many kernels in the phase
+    // touch it, and chunk-sized temporaries are assumed to stay
+    // in cache.  Write-allocate traffic is not counted.
+    const double np = mesh->nump;
+    const double ne = mesh->nume;
+    const double nz = mesh->numz;
+    const double ns = mesh->nums;
+    const double I = sizeof(int);
+    const double D = sizeof(double);
+    const double V = 2 * sizeof(double);
+
+    bytes.assign(Timer::NUMPHASES, 0.);
+    flops.assign(Timer::NUMPHASES, 0.);
+
+    // px, pu -> px0, pu0, pxp
+    bytes[Timer::PH_PREDPT] = 5 * V * np;
+    flops[Timer::PH_PREDPT] = 4 * np;
+
+    // mapsp1, mapsp2, mapse, mapsz, znump, pxp -> exp, zxp
+    bytes[Timer::PH_PREDCTRS] = 4 * I * ns + I * nz + V * np +
+            V * ne + V * nz;
+    flops[Timer::PH_PREDCTRS] = 6 * ns + 2 * nz;
+
+    // mapsp1, mapsp2, mapsz, pxp, zxp -> sareap, svolp, zareap, zvolp
+    bytes[Timer::PH_PREDVOLS] = 3 * I * ns + V * np + V * nz +
+            2 * D * ns + 2 * D * nz;
+    flops[Timer::PH_PREDVOLS] = 14 * ns;
+
+    // zvol -> zvol0;
+    // mapsp1, mapsp2, mapsz, mapse, znump, pxp, exp, zxp, sareap
+    //     -> ssurfp, elen, zdl
+    bytes[Timer::PH_PREDGEOM] = 2 * D * nz + 4 * I * ns + I * nz +
+            V * np + V * ne + V * nz + D * ns +
+            V * ns + D * ne + D * nz;
+    flops[Timer::PH_PREDGEOM] = 11 * ns;
+
+    // zm, zvolp -> zrp;  mapss3, mapsz, zareap, smf -> cmaswt
+    bytes[Timer::PH_MASS] = 3 * D * nz + 2 * I * ns + D * nz +
+            2 * D * ns;
+    flops[Timer::PH_MASS] = nz + 4 * ns;
+
+    // zr, zvolp, zvol0, ze, zwrate, zm -> zp, zss
+    bytes[Timer::PH_STATE] = 8 * D * nz;
+    flops[Timer::PH_STATE] = 25 * nz;
+
+    // mapsz, zp, ssurfp -> sfp
+    bytes[Timer::PH_PGASF] = I * ns + D * nz + 2 * V * ns;
+    flops[Timer::PH_PGASF] = 2 * ns;
+
+    // mapsz, zareap, zrp, zss, sareap, smf, ssurfp -> sft
+    bytes[Timer::PH_TTSF] = I * ns + 3 * D * nz + 2 * D * ns +
+            2 * V * ns;
+    flops[Timer::PH_TTSF] = 10 * ns;
+
+    // mapsp1, mapsp2, mapsz, mapss3, mapse, znump, pu, pxp, exp,
+    //     zxp, elen -> (chunk temporaries)
+    bytes[Timer::PH_QCSDIV] = 5 * I * ns + I * nz + 2 * V * np +
+            V * ne + V * nz + D * ne;
+    flops[Timer::PH_QCSDIV] = 120 * ns + 2 * nz;
+
+    // mapsp1, mapsp2, mapsz, mapss3, mapss4, mapse, zss, zrp, pu,
+    //     pxp, elen -> sfq, zdu
+    bytes[Timer::PH_QCSF] = 6 * I * ns + 3 * D * nz + 2 * V * np +
+            D * ne + V * ns;
+    flops[Timer::PH_QCSF] = 55 * ns + 3 * nz;
+
+    // mapss3, sfp, sfq, sft -> cftot
+    bytes[Timer::PH_CRNRF] = I * ns + 4 * V * ns;
+    flops[Timer::PH_CRNRF] = 10 * ns;
+
+    // cmaswt, cftot, point-corner maps -> pmaswt, pf;
+    //     rect grids use a stencil instead of the maps
+    bytes[Timer::PH_SUMONPROC] = (D + V) * ns + (D + V) * np;
+    if (mesh->rectnzx == 0)
+        bytes[Timer::PH_SUMONPROC] += 2 * (I * np + I * ns);
+    flops[Timer::PH_SUMONPROC] = 3 * ns;
+
+    // pf, pmaswt, px0, pu0 -> pap, px, pu
+    bytes[Timer::PH_CORRPT] = 7 * V * np + D * np;
+    flops[Timer::PH_CORRPT] = 14 * np;
+
+    bytes[Timer::PH_CORRCTRS] = bytes[Timer::PH_PREDCTRS];
+    flops[Timer::PH_CORRCTRS] = flops[Timer::PH_PREDCTRS];
+    bytes[Timer::PH_CORRVOLS] = bytes[Timer::PH_PREDVOLS];
+    flops[Timer::PH_CORRVOLS] = flops[Timer::PH_PREDVOLS];
+
+    // fused predictor geometry:  maps and pxp read once, all
+    // geometry written once
+    if (mesh->fusedgeom) {
+        bytes[Timer::PH_PREDGEOM] = 2 * D * nz + 4 * I * ns + I * nz +
+                V * np + V * ne + V * nz + 2 * D * ns + 2 * D * nz +
+                V * ns + D * ne + D * nz;
+        flops[Timer::PH_PREDGEOM] += flops[Timer::PH_PREDCTRS] +
+                flops[Timer::PH_PREDVOLS];
+        bytes[Timer::PH_PREDCTRS] = flops[Timer::PH_PREDCTRS] = 0.;
+        bytes[Timer::PH_PREDVOLS] = flops[Timer::PH_PREDVOLS] = 0.;
+    }
+
+    // fused forces:  mapsz, zp, zareap, zrp, zss, sareap, smf,
+    //     ssurfp, sfq -> sfq, cftot
+    if (hydro->fusedforce) {
+        bytes[Timer::PH_CRNRF] = I * ns + 4 * D * nz + 2 * D * ns +
+                4 * V * ns;
+        flops[Timer::PH_CRNRF] += flops[Timer::PH_PGASF] +
+                flops[Timer::PH_TTSF];
+        bytes[Timer::PH_PGASF] = flops[Timer::PH_PGASF] = 0.;
+        bytes[Timer::PH_TTSF] = flops[Timer::PH_TTSF] = 0.;
+    }
+
+    // lean memory:  sareap, svolp and ssurfp are not written, and
+    //     the fused forces read mapsp1, mapsp2, mapse, pxp, exp,
+    //     zxp in their place; the corrector reads mapsp1, mapsp2,
+    //     mapsz, znump, px -> zx, zarea, zvol in one pass
+    if (mesh->leanmem) {
+        bytes[Timer::PH_PREDGEOM] -= 2 * D * ns + V * ns;
+        flops[Timer::PH_PREDGEOM] -= 2 * ns;
+        bytes[Timer::PH_CRNRF] += 3 * I * ns + V * np + V * ne + V * nz -
+                D * ns - V * ns;
+        flops[Timer::PH_CRNRF] += 10 * ns;
+        bytes[Timer::PH_CORRVOLS] = 3 * I * ns + I * nz + V * np +
+                V * nz + 2 * D * nz;
+        flops[Timer::PH_CORRVOLS] = 16 * ns + 2 * nz;
+        bytes[Timer::PH_CORRCTRS] = flops[Timer::PH_CORRCTRS] = 0.;
+    }
+
+    // mapsp1, mapsp2, mapsz, sfp, sfq, pu0, pu, pxp, zetot
+    //     -> zw, zetot
+    bytes[Timer::PH_WORK] = 3 * I * ns + 2 * V * ns + 3 * V * np +
+            3 * D * nz;
+    if (hydro->fusedforce) bytes[Timer::PH_WORK] -= V * ns;
+    flops[Timer::PH_WORK] = 20 * ns;
+
+    // zvol0, zvol, zw, zp, zetot, zm -> zwrate, ze, zr
+    bytes[Timer::PH_ZONEUPD] = 9 * D * nz;
+    flops[Timer::PH_ZONEUPD] = 7 * nz;
+
+    // zdu, zss, zdl, zvol, zvol0
+    bytes[Timer::PH_DTHYDRO] = 5 * D * nz;
+    flops[Timer::PH_DTHYDRO] = 8 * nz;
+
+    // the side loops above are counted as reading every map they
+    // use; take out the zone maps (mapsz, mapss3, mapss4, znump)
+    // and the point and edge maps (mapsp1, mapsp2, mapse) if the
+    // side map chosen for this mesh computes them instead.  The
+    // SIMD QCS loops still read all but mapss4 and znump.
+    bool zonemaps, pointmaps;
+    const MapsReadOp op = { &zonemaps, &pointmaps };
+    dispatchSideMap(mesh, op);
+    const bool qcssimd = (hydro->qcs->simd != QCSSimd::NONE);
+    if (!zonemaps) {
+        vector<double> zmaps(Timer::NUMPHASES, 0.);
+        zmaps[Timer::PH_PREDCTRS] = I * ns + I * nz;
+        zmaps[Timer::PH_PREDVOLS] = I * ns;
+        zmaps[Timer::PH_PREDGEOM] = I * ns + I * nz;
+        zmaps[Timer::PH_MASS] = 2 * I * ns;
+        zmaps[Timer::PH_PGASF] = I * ns;
+        zmaps[Timer::PH_TTSF] = I * ns;
+        zmaps[Timer::PH_QCSDIV] = (qcssimd ? 0. : 2 * I * ns) + I * nz;
+        zmaps[Timer::PH_QCSF] = (hydro->qcs->simdforce ? 1 : 3) * I * ns;
+        zmaps[Timer::PH_CRNRF] = I * ns;
+        zmaps[Timer::PH_CORRCTRS] = I * ns + I * nz;
+        zmaps[Timer::PH_CORRVOLS] = I * ns + (mesh->leanmem ? I * nz : 0.);
+        zmaps[Timer::PH_WORK] = I * ns;
+        // phases merged into others by fusedgeom, fusedforce or
+        // leanmem have no traffic left
+        for (int ph = 0; ph < Timer::NUMPHASES; ++ph)
+            if (bytes[ph] > 0.) bytes[ph] -= zmaps[ph];
+    }
+    if (!pointmaps) {
+        vector<double> pmaps(Timer::NUMPHASES, 0.);
+        pmaps[Timer::PH_PREDCTRS] = 3 * I * ns;
+        pmaps[Timer::PH_PREDVOLS] = 2 * I * ns;
+        pmaps[Timer::PH_PREDGEOM] = 3 * I * ns;
+        pmaps[Timer::PH_QCSDIV] = (qcssimd ? 0. : 3 * I * ns);
+        pmaps[Timer::PH_QCSF] = (hydro->qcs->simdforce ? 0. : 3 * I * ns);
+        pmaps[Timer::PH_CRNRF] = (mesh->leanmem ? 3 * I * ns : 0.);
+        pmaps[Timer::PH_CORRCTRS] = 3 * I * ns;
+        pmaps[Timer::PH_CORRVOLS] = 2 * I * ns;
+        pmaps[Timer::PH_WORK] = 2 * I * ns;
+        for (int ph = 0; ph < Timer::NUMPHASES; ++ph)
+            if (bytes[ph] > 0.) bytes[ph] -= pmaps[ph];
+    }
+
+    // sum over PEs
+    for (int ph = 0; ph < Timer::NUMPHASES; ++ph) {
+        Parallel::globalSum(bytes[ph]);
+        Parallel::globalSum(flops[ph]);
+    }
+
+}
+
+
+double Roofline::probeBandwidth() {
+
+    const int n = streamsize;
+    double* a = Memory::alloc<double>(n, "roofline probe");
+    double* b = Memory::alloc<double>(n, "roofline probe");
+    double* c = Memory::alloc<double>(n, "roofline probe");
+
+    // first-touch with the same static schedule as the probe
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) {
+        a[i] = 0.;
+        b[i] = 1.;
+        c[i] = 2.;
+    }
+
+    // all PEs run the probe at the same time, so that PEs
+    // sharing a node also share its bandwidth
+    Parallel::barrier();
+    double tbest = 1.e99;
+    const double scalar = 3.;
+    for (int rep = 0; rep < streamreps; ++rep) {
+        double t0 = Timer::now();
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i)
+            a[i] = b[i] + scalar * c[i];
+        tbest = min(tbest, Timer::now() - t0);
+    }
+    Parallel::barrier();
+
+    Memory::free(a);
+    Memory::free(b);
+    Memory::free(c);
+
+    double bw = 3. * sizeof(double) * n / max(tbest, 1.e-99);
+    Parallel::globalSum(bw);
+    return bw;
+
+}
+
+
+void Roofline::write(
+        const double* phtime,
+        const int cycles) {
+
+    if (Parallel::mype > 0) return;
+
+    cout << endl;
+    cout << "--- Roofline (model traffic/flops vs. measured time) ---"
+         << endl;
+    cout << left << setw(16) << "phase" << right
+         << setw(11) << "MB/cycle" << setw(11) << "MF/cycle"
+         << setw(8) << "F/B" << setw(9) << "GB/s"
+         << setw(9) << "GF/s" << setw(9) << "%STREAM" << endl;
+    double bsum = 0., fsum = 0., tsum = 0.;
+    for (int ph = 0; ph < Timer::NUMPHASES; ++ph) {
+        if (bytes[ph] == 0.) continue;
+        double t = phtime[ph];
+        double gbs = (t > 0. ? bytes[ph] * cycles / t * 1.e-9 : 0.);
+        double gfs = (t > 0. ? flops[ph] * cycles / t * 1.e-9 : 0.);
+        cout << left << setw(16) << Timer::phasename[ph] << right;
+        cout << fixed << setprecision(3);
+        cout << setw(11) << bytes[ph] * 1.e-6;
+        cout << setw(11) << flops[ph] * 1.e-6;
+        cout << setprecision(2);
+        cout << setw(8) << flops[ph] / bytes[ph];
+        cout << setw(9) << gbs;
+        cout << setw(9) << gfs;
+        cout << setprecision(1);
+        cout << setw(9) << 100. * gbs * 1.e9 / streambw << endl;
+        bsum += bytes[ph];
+        fsum += flops[ph];
+        tsum += t;
+    }
+    double gbs = (tsum > 0. ? bsum * cycles / tsum * 1.e-9 : 0.);
+    double gfs = (tsum > 0. ? fsum * cycles / tsum * 1.e-9 : 0.);
+    cout << left << setw(16) << "total" << right;
+    cout << fixed << setprecision(3);
+    cout << setw(11) << bsum * 1.e-6 << setw(11) << fsum * 1.e-6;
+    cout << setprecision(2);
+    cout << setw(8) << fsum / bsum << setw(9) << gbs << setw(9) << gfs;
+    cout << setprecision(1);
+    cout << setw(9) << 100. * gbs * 1.e9 / streambw << endl;
+    cout << "STREAM triad:  " << setprecision(2)
+         << streambw * 1.e-9 << " GB/s" << endl;
+    cout << "------------------------" << endl;
+
+}
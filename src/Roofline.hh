@@ -0,0 +1,61 @@
+/*
+ * Roofline.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef ROOFLINE_HH_
+#define ROOFLINE_HH_
+
+#include <vector>
+
+// forward declarations
+class InputFile;
+class Mesh;
+class Hydro;
+
+
+// Class Roofline holds a static model of the minimum memory
+// traffic and floating-point work of each phase of the hydro
+// cycle, computed from the mesh sizes.  Combined with measured
+// phase times, it reports achieved bandwidth and flop rates,
+// compared against a STREAM-style bandwidth probe run at startup.
+
+class Roofline {
+public:
+
+    // associated mesh and hydro objects
+    const Mesh* mesh;
+    const Hydro* hydro;
+
+    int streamsize;                // array length for bandwidth probe
+    int streamreps;                // number of probe repetitions
+    double streambw;               // measured triad bandwidth (B/s),
+                                   // summed over PEs
+    std::vector<double> bytes;     // min. bytes moved per cycle,
+                                   // for each timer phase
+    std::vector<double> flops;     // flops per cycle, for each phase
+
+    Roofline(const InputFile* inp, const Mesh* m, const Hydro* h);
+    ~Roofline();
+
+    // compute traffic and flop counts for each phase
+    void calcModel();
+
+    // run STREAM triad probe, return bandwidth in B/s
+    double probeBandwidth();
+
+    // write table of achieved vs. model rates
+    void write(
+            const double* phtime,
+            const int cycles);
+
+};  // class Roofline
+
+
+#endif /* ROOFLINE_HH_ */
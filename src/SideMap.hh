@@ -0,0 +1,171 @@
+/*
+ * SideMap.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef SIDEMAP_HH_
+#define SIDEMAP_HH_
+
+#include "Mesh.hh"
+
+
+// Side loops in Mesh, Hydro, QCS, PolyGas and TTS are written as
+// templates on a side map class, which gives the relations of a
+// side s to the rest of the mesh:
+//     zone(s)             zone containing s (mapsz)
+//     prev(s), next(s)    previous and next sides in the zone
+//                         (mapss3, mapss4)
+//     p1(s), p2(s)        points of s (mapsp1, mapsp2)
+//     edge(s)             edge of s (mapse)
+//     size(z)             number of sides in zone z (znump)
+// and says whether it reads the zone maps (mapsz, mapss3, mapss4,
+// znump) for these, in zonemaps, and the point and edge maps
+// (mapsp1, mapsp2, mapse), in pointmaps.
+// Each kernel is instantiated for every side map class, and a
+// non-template version chooses among them for the current mesh
+// with dispatchSideMap, below.
+
+// general meshes:  all relations are read from the mesh maps
+class SideMapGeneral {
+public:
+    const int* mapsz;
+    const int* mapss3;
+    const int* mapss4;
+    const int* mapsp1;
+    const int* mapsp2;
+    const int* mapse;
+    const int* znump;
+
+    explicit SideMapGeneral(const Mesh* mesh) :
+        mapsz(mesh->mapsz), mapss3(mesh->mapss3), mapss4(mesh->mapss4),
+        mapsp1(mesh->mapsp1), mapsp2(mesh->mapsp2), mapse(mesh->mapse),
+        znump(mesh->znump) {}
+
+    static const bool zonemaps = true;
+    static const bool pointmaps = true;
+
+    int zone(const int s) const { return mapsz[s]; }
+    int prev(const int s) const { return mapss3[s]; }
+    int next(const int s) const { return mapss4[s]; }
+    int p1(const int s) const { return mapsp1[s]; }
+    int p2(const int s) const { return mapsp2[s]; }
+    int edge(const int s) const { return mapse[s]; }
+    int size(const int z) const { return znump[z]; }
+};
+
+
+// meshes where every zone has N sides, numbered N per zone in
+// zone order (see Mesh::zonesides):  the zone and neighboring
+// sides of a side, and the size of a zone, are computed, and only
+// the point and edge maps are read
+template <int N>
+class SideMapUniform {
+public:
+    const int* mapsp1;
+    const int* mapsp2;
+    const int* mapse;
+
+    explicit SideMapUniform(const Mesh* mesh) :
+        mapsp1(mesh->mapsp1), mapsp2(mesh->mapsp2),
+        mapse(mesh->mapse) {}
+
+    static const bool zonemaps = false;
+    static const bool pointmaps = true;
+
+    // side numbers are never negative, so unsigned division
+    // lets the compiler use a shift for N a power of 2
+    int zone(const int s) const { return (unsigned) s / N; }
+    int prev(const int s) const {
+        return ((unsigned) s % N == 0 ? s + N - 1 : s - 1);
+    }
+    int next(const int s) const {
+        return ((unsigned) s % N == N - 1 ? s - N + 1 : s + 1);
+    }
+    int p1(const int s) const { return mapsp1[s]; }
+    int p2(const int s) const { return mapsp2[s]; }
+    int edge(const int s) const { return mapse[s]; }
+    int size(const int) const { return N; }
+};
+
+// all-quadrilateral meshes, such as those from meshtype rect
+typedef SideMapUniform<4> SideMapQuad;
+
+
+// structured rect grids (see Mesh::rectnzx):  zone z = j * nzx + i
+// has lower left point p0 = j * (nzx + 1) + i and sides 4z (bottom),
+// 4z+1 (right), 4z+2 (top), 4z+3 (left), so that every relation is
+// computed and no map is read.  Horizontal edges are numbered first,
+// by row, then vertical edges, by row.
+class SideMapRect : public SideMapQuad {
+public:
+    int nzx;            // zones in x direction
+    int npx;            // points in x direction
+    int neh;            // number of horizontal edges
+    double rnzx;        // 1 / nzx
+
+    explicit SideMapRect(const Mesh* mesh) : SideMapQuad(mesh) {
+        nzx = mesh->rectnzx;
+        npx = nzx + 1;
+        neh = nzx * (mesh->rectnzy + 1);
+        rnzx = 1. / (double) nzx;
+    }
+
+    static const bool pointmaps = false;
+
+    // row of zone z; the half keeps the product away from the
+    // next integer below, so it truncates correctly for any mesh
+    // with fewer than about 2^50 / nzx zones
+    int row(const int z) const { return (int) ((z + 0.5) * rnzx); }
+
+    // point k of zone z, counterclockwise from the lower left:
+    // p0, p0 + 1, p0 + npx + 1, p0 + npx
+    int point(const int z, const int k) const {
+        return z + row(z) + ((k ^ (k >> 1)) & 1) + (k >> 1) * npx;
+    }
+
+    int p1(const int s) const { return point(zone(s), s & 3); }
+    int p2(const int s) const { return point(zone(s), (s + 1) & 3); }
+
+    // bottom and top edges are horizontal edges z and z + nzx;
+    // right and left are vertical edges z + j + 1 and z + j
+    int edge(const int s) const {
+        const int z = zone(s);
+        const int k = s & 3;
+        return ((k & 1) ? neh + z + row(z) + (k == 1) :
+                z + (k >> 1) * nzx);
+    }
+};
+
+
+// call f(sm) with the side map class for mesh:  if uniformsides
+// is set and every zone is a quadrilateral, SideMapRect for
+// structured rect grids with structured set, SideMapQuad for the
+// rest; otherwise SideMapGeneral.  f is a function object with a
+// member template operator()(const SM sm) const, which calls a
+// kernel's template version.
+template <typename F>
+inline void dispatchSideMap(const Mesh* mesh, const F& f) {
+    if (!mesh->uniformsides || mesh->zonesides != 4)
+        f(SideMapGeneral(mesh));
+    else if (mesh->rectnzx > 0 && mesh->structured)
+        f(SideMapRect(mesh));
+    else
+        f(SideMapQuad(mesh));
+}
+
+
+// FOR_EACH_SIDEMAP(M, A) expands M(A, SM) for each side map class,
+// for explicit instantiation of kernels (see FieldTypes.hh)
+#define FOR_EACH_SIDEMAP(M, A) \
+    M(A, SideMapGeneral) \
+    M(A, SideMapQuad) \
+    M(A, SideMapRect)
+
+
+#endif /* SIDEMAP_HH_ */
@@ -15,11 +15,40 @@
 #include "Vec2.hh"
 #include "InputFile.hh"
 #include "Mesh.hh"
+#include "SideMap.hh"
 #include "Hydro.hh"
 
 using namespace std;
 
 
+namespace {
+
+// function object for dispatchSideMap (see SideMap.hh):  calls
+// calcForce's FieldsOne version with the side map given
+
+struct CalcForceOp {
+    double alfa;
+    double ssmin;
+    const double* zarea;
+    const double* zr;
+    const double* zss;
+    const double* sarea;
+    const double* smf;
+    const_double2ptr ssurfp;
+    double2ptr sf;
+    int sfirst;
+    int slast;
+
+    template <typename SM>
+    void operator()(const SM sm) const {
+        TTS::calcForce<FieldsOne>(sm, alfa, ssmin, zarea, zr, zss, sarea, smf,
+                ssurfp, sf, sfirst, slast);
+    }
+};
+
+}  // namespace
+
+
 TTS::TTS(const InputFile* inp, Hydro* h) : hydro(h) {
     alfa = inp->getDouble("alfa", 0.5);
     ssmin = inp->getDouble("ssmin", 0.);
@@ -36,11 +65,37 @@ void TTS::calcForce(
         const double* zss,
         const double* sarea,
         const double* smf,
-        const double2* ssurfp,
-        double2* sf,
+        const_double2ptr ssurfp,
+        double2ptr sf,
+        const int sfirst,
+        const int slast) {
+
+    const Mesh* mesh = hydro->mesh;
+    const CalcForceOp op = { alfa, ssmin, zarea, zr, zss, sarea, smf, ssurfp,
+            sf, sfirst, slast };
+    dispatchSideMap(mesh, op);
+
+}
+
+
+template <typename FT, typename SM>
+void TTS::calcForce(
+        const SM sm,
+        const typename FT::real alfa,
+        const typename FT::real ssmin,
+        typename FT::cptr zarea,
+        typename FT::cptr zr,
+        typename FT::cptr zss,
+        typename FT::cptr sarea,
+        const double* smf,
+        typename FT::cptr2 ssurfp,
+        typename FT::ptr2 sf,
         const int sfirst,
         const int slast) {
 
+    typedef typename FT::real real;
+    typedef typename FT::real2 real2;
+
     //  Side density:
     //    srho = sm/sv = zr (sm/zm) / (sv/zv)
     //  Side pressure:
@@ -53,21 +108,27 @@ void TTS::calcForce(
     //    Notes: smf stores (sm/zm)
     //           svfac stores (sv/zv)
 
-    const Mesh* mesh = hydro->mesh;
-
     #pragma ivdep
     for (int s = sfirst; s < slast; ++s) {
-        int z = mesh->mapsz[s];
+        int z = sm.zone(s);
 
-        double svfacinv = zarea[z] / sarea[s];
-        double srho = zr[z] * smf[s] * svfacinv;
-        double sstmp = max(zss[z], ssmin);
+        real svfacinv = zarea[z] / sarea[s];
+        real srho = zr[z] * smf[s] * svfacinv;
+        real sstmp = max(zss[z], ssmin);
         sstmp = alfa * sstmp * sstmp;
-        double sdp = sstmp * (srho - zr[z]);
-        double2 sqq = -sdp * ssurfp[s];
+        real sdp = sstmp * (srho - zr[z]);
+        real2 sqq = -sdp * ssurfp[s];
         sf[s] = sqq;
 
     }
 
 }
 
+
+// kernels used by HydroLanes groups (see FieldTypes.hh)
+#define INSTANTIATE_LANES_SM(FT, SM) \
+    template void TTS::calcForce<FT, SM>(const SM, const FT::real, \
+            const FT::real, FT::cptr, FT::cptr, FT::cptr, FT::cptr, \
+            const double*, FT::cptr2, FT::ptr2, const int, const int);
+FOR_EACH_LANES_SM(INSTANTIATE_LANES_SM)
+#undef INSTANTIATE_LANES_SM
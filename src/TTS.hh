@@ -13,7 +13,8 @@
 #ifndef TTS_HH_
 #define TTS_HH_
 
-#include "Vec2.hh"
+#include "Vec2Array.hh"
+#include "FieldTypes.hh"
 
 // forward declarations
 class InputFile;
@@ -32,14 +33,30 @@ public:
     TTS(const InputFile* inp, Hydro* h);
     ~TTS();
 
+// plain version for this problem, which calls the static version
+// templated on field types (see FieldTypes.hh) with FieldsOne
 void calcForce(
         const double* zarea,
         const double* zr,
         const double* zss,
         const double* sarea,
         const double* smf,
-        const double2* ssurfp,
-        double2* sf,
+        const_double2ptr ssurfp,
+        double2ptr sf,
+        const int sfirst,
+        const int slast);
+template <typename FT, typename SM>
+static void calcForce(
+        const SM sm,
+        const typename FT::real alfa,
+        const typename FT::real ssmin,
+        typename FT::cptr zarea,
+        typename FT::cptr zr,
+        typename FT::cptr zss,
+        typename FT::cptr sarea,
+        const double* smf,
+        typename FT::cptr2 ssurfp,
+        typename FT::ptr2 sf,
         const int sfirst,
         const int slast);
 
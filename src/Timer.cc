@@ -0,0 +1,235 @@
+/*
+ * Timer.cc
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#include "Timer.hh"
+
+#include <ctime>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+#include "Parallel.hh"
+#include "InputFile.hh"
+#include "PerfCounters.hh"
+
+using namespace std;
+
+
+const char* Timer::phasename[Timer::NUMPHASES] = {
+    "pred points",
+    "pred ctrs",
+    "pred vols",
+    "pred geometry",
+    "pred mass",
+    "pred state",
+    "pgas force",
+    "tts force",
+    "qcs div",
+    "qcs force",
+    "crnr force",
+    "sum on proc",
+    "sum across pes",
+    "corr points",
+    "corr ctrs",
+    "corr vols",
+    "corr work",
+    "corr zone upd",
+    "dt hydro",
+    "dt global"
+};
+
+
+Timer::Timer(const InputFile* inp) : perf(NULL) {
+    enabled = inp->getInt("phasetimers", 1);
+    writejson = inp->getInt("writetimers", 0);
+    bool perfcounters = inp->getInt("perfcounters", 0);
+
+#ifdef _OPENMP
+    numthr = omp_get_max_threads();
+#else
+    numthr = 1;
+#endif
+    // pad each thread's slots out to a full 64-byte cache line
+    stride = (NUMPHASES + 7) / 8 * 8 + 8;
+    thrtime.resize(numthr * stride);
+
+    // counters are read at the timer laps, so they need the
+    // timers to be on
+    if (perfcounters && enabled) {
+        perf = new PerfCounters(numthr, NUMPHASES);
+        // each thread opens its own counter group
+        #pragma omp parallel
+        {
+            perf->openThread(thread());
+        }
+        perf->finishOpen();
+    }
+
+    reset();
+}
+
+
+Timer::~Timer() {
+    delete perf;
+}
+
+
+double Timer::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.e-9;
+}
+
+
+void Timer::perfStart(const int thr) {
+    perf->start(thr);
+}
+
+
+void Timer::perfLap(const int thr, const int ph) {
+    perf->lap(thr, ph);
+}
+
+
+void Timer::reset() {
+    fill(thrtime.begin(), thrtime.end(), 0.);
+    if (perf) perf->reset();
+}
+
+
+void Timer::write(
+        const string& probname,
+        const int cycles) {
+
+    using Parallel::numpe;
+    using Parallel::mype;
+
+    if (!enabled) return;
+
+    // for each phase, compute min/avg/max over all threads on all
+    // PEs, and min/avg/max over PEs of the per-PE time (which is
+    // the time of the slowest thread on that PE)
+    const int nstat = 6;
+    vector<double> stats(NUMPHASES * nstat);
+    for (int ph = 0; ph < NUMPHASES; ++ph) {
+        double thrmin = 1.e99, thrsum = 0., thrmax = 0.;
+        for (int thr = 0; thr < numthr; ++thr) {
+            double t = thrtime[thr * stride + ph];
+            thrmin = min(thrmin, t);
+            thrsum += t;
+            thrmax = max(thrmax, t);
+        }
+        double pemin = thrmax, pesum = thrmax, pemax = thrmax;
+
+        Parallel::globalMin(thrmin);
+        Parallel::globalSum(thrsum);
+        Parallel::globalMax(thrmax);
+        Parallel::globalMin(pemin);
+        Parallel::globalSum(pesum);
+        Parallel::globalMax(pemax);
+
+        double* st = &stats[ph * nstat];
+        st[0] = thrmin;
+        st[1] = thrsum / (numthr * numpe);
+        st[2] = thrmax;
+        st[3] = pemin;
+        st[4] = pesum / numpe;
+        st[5] = pemax;
+    }
+
+    if (mype == 0) writeTable(cycles, stats);
+
+    petime.resize(NUMPHASES);
+    for (int ph = 0; ph < NUMPHASES; ++ph)
+        petime[ph] = stats[ph * nstat + 5];
+
+    if (perf) perf->write(phasename, &petime[0]);
+
+    if (mype == 0 && writejson) writeJson(probname, cycles, stats);
+
+}
+
+
+void Timer::writeTable(
+        const int cycles,
+        const vector<double>& stats) {
+
+    using Parallel::numpe;
+
+    const int nstat = 6;
+    double pesumtot = 0.;
+    for (int ph = 0; ph < NUMPHASES; ++ph)
+        pesumtot += stats[ph * nstat + 4];
+
+    cout << endl;
+    cout << "--- Phase Timing (seconds, " << cycles << " cycles, "
+         << numpe << " PE(s) x " << numthr << " thread(s)) ---"
+         << endl;
+    cout << left << setw(16) << "phase" << right
+         << setw(11) << "thr min" << setw(11) << "thr avg"
+         << setw(11) << "thr max" << setw(11) << "pe min"
+         << setw(11) << "pe avg" << setw(11) << "pe max"
+         << setw(8) << "%" << endl;
+    for (int ph = 0; ph < NUMPHASES; ++ph) {
+        const double* st = &stats[ph * nstat];
+        cout << left << setw(16) << phasename[ph] << right;
+        cout << scientific << setprecision(3);
+        for (int i = 0; i < nstat; ++i)
+            cout << setw(11) << st[i];
+        cout << fixed << setprecision(2);
+        cout << setw(8) << 100. * st[4] / max(pesumtot, 1.e-99) << endl;
+    }
+    cout << left << setw(16) << "total" << right;
+    cout << scientific << setprecision(3);
+    cout << setw(55) << pesumtot << endl;
+    cout << "------------------------" << endl;
+
+}
+
+
+void Timer::writeJson(
+        const string& probname,
+        const int cycles,
+        const vector<double>& stats) {
+
+    const string filename = probname + ".timers.json";
+    ofstream ofs(filename.c_str());
+    if (!ofs.good()) {
+        cerr << "Cannot open file " << filename << " for writing"
+             << endl;
+        return;
+    }
+
+    const int nstat = 6;
+    ofs << scientific << setprecision(6);
+    ofs << "{" << endl;
+    ofs << "  \"problem\": \"" << probname << "\"," << endl;
+    ofs << "  \"cycles\": " << cycles << "," << endl;
+    ofs << "  \"numpe\": " << Parallel::numpe << "," << endl;
+    ofs << "  \"numthreads\": " << numthr << "," << endl;
+    ofs << "  \"phases\": [" << endl;
+    for (int ph = 0; ph < NUMPHASES; ++ph) {
+        const double* st = &stats[ph * nstat];
+        ofs << "    { \"name\": \"" << phasename[ph] << "\", "
+            << "\"thread\": { \"min\": " << st[0]
+            << ", \"avg\": " << st[1]
+            << ", \"max\": " << st[2] << " }, "
+            << "\"pe\": { \"min\": " << st[3]
+            << ", \"avg\": " << st[4]
+            << ", \"max\": " << st[5] << " } }"
+            << (ph + 1 < NUMPHASES ? "," : "") << endl;
+    }
+    ofs << "  ]" << endl;
+    ofs << "}" << endl;
+    ofs.close();
+
+}
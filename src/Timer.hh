@@ -0,0 +1,135 @@
+/*
+ * Timer.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef TIMER_HH_
+#define TIMER_HH_
+
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// forward declarations
+class InputFile;
+class PerfCounters;
+
+
+// Class Timer accumulates wall-clock time spent in each phase of
+// the hydro cycle.  Each thread has its own set of accumulators,
+// so timing calls can be made from inside parallel chunk loops
+// without synchronization.  At the end of the run, the per-thread
+// totals are reduced across threads and PEs into min/avg/max
+// tables.  Optionally, hardware counters are read at the same
+// points and attributed to the same phases.
+
+class Timer {
+public:
+
+    // phases of the hydro cycle, in order of execution
+    enum Phase {
+        PH_PREDPT,        // predictor: save state, advance points
+        PH_PREDCTRS,      // predictor: edge, zone centers
+        PH_PREDVOLS,      // predictor: side, zone volumes
+        PH_PREDGEOM,      // predictor: other mesh geometry
+        PH_MASS,          // predictor: zone density, corner mass
+        PH_STATE,         // predictor: EOS at half step
+        PH_PGASF,         // predictor: PolyGas forces
+        PH_TTSF,          // predictor: TTS forces
+        PH_QCSDIV,        // predictor: QCS corner divergence
+        PH_QCSF,          // predictor: other QCS forces
+        PH_CRNRF,         // predictor: sum corner forces
+        PH_SUMONPROC,     // sumToPoints, on-PE sums
+        PH_SUMACROSS,     // sumToPoints, across-PE sums
+        PH_CORRPT,        // corrector: BCs, accel, advance points
+        PH_CORRCTRS,      // corrector: edge, zone centers
+        PH_CORRVOLS,      // corrector: side, zone volumes
+        PH_WORK,          // corrector: work
+        PH_ZONEUPD,       // corrector: work rate, energy, density
+        PH_DTHYDRO,       // corrector: hydro timestep
+        PH_GLOBALDT,      // global timestep reduction
+        NUMPHASES
+    };
+    static const char* phasename[NUMPHASES];
+
+    bool enabled;                  // flag:  accumulate phase times?
+    bool writejson;                // flag:  write .timers.json file?
+    PerfCounters* perf;            // hardware counters (NULL if off)
+    int numthr;                    // number of per-thread slots
+    int stride;                    // distance between thread slots
+                                   // (padded to avoid false sharing)
+    std::vector<double> thrtime;   // accumulated time, indexed by
+                                   // [thread * stride + phase]
+    std::vector<double> petime;    // time per phase on slowest PE,
+                                   // set by write()
+
+    Timer(const InputFile* inp);
+    ~Timer();
+
+    // current wall-clock time, in seconds
+    static double now();
+
+    // start timing:  returns a timestamp to pass to lap()
+    double start() {
+        if (!enabled) return 0.;
+        if (perf) perfStart(thread());
+        return now();
+    }
+
+    // add time since t0 to the given phase for the calling
+    // thread; returns the current time for use as the next t0
+    double lap(const int ph, const double t0) {
+        if (!enabled) return 0.;
+        double t = now();
+        int thr = thread();
+        thrtime[thr * stride + ph] += t - t0;
+        if (perf) perfLap(thr, ph);
+        return t;
+    }
+
+    // helpers for counter reads (out of line, to keep
+    // PerfCounters.hh out of this header)
+    void perfStart(const int thr);
+    void perfLap(const int thr, const int ph);
+
+    // index of calling thread
+    int thread() const {
+#ifdef _OPENMP
+        int thr = omp_get_thread_num();
+        return (thr < numthr ? thr : numthr - 1);
+#else
+        return 0;
+#endif
+    }
+
+    // zero all accumulators
+    void reset();
+
+    // reduce across threads and PEs, and write timing tables
+    void write(
+            const std::string& probname,
+            const int cycles);
+
+    // write timing table (PE 0 only)
+    void writeTable(
+            const int cycles,
+            const std::vector<double>& stats);
+
+    // write reduced values to JSON file (PE 0 only)
+    void writeJson(
+            const std::string& probname,
+            const int cycles,
+            const std::vector<double>& stats);
+
+}; // class Timer
+
+
+#endif /* TIMER_HH_ */
@@ -175,7 +175,7 @@ inline double2 rotateCW(const double2& v)
 
 // project v onto subspace perpendicular to u
 // u must be a unit vector
-inline double2 project(double2& v, const double2& u)
+inline double2 project(const double2& v, const double2& u)
 {
     // assert(length2(u) == 1.);
     return v - dot(v, u) * u;
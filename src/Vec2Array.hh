@@ -0,0 +1,170 @@
+/*
+ * Vec2Array.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef VEC2ARRAY_HH_
+#define VEC2ARRAY_HH_
+
+#include <cstdlib>
+
+#include "Vec2.hh"
+#include "Memory.hh"
+
+
+// Arrays of double2 (the point, edge, zone and side vector fields)
+// are stored in one of two layouts, chosen at compile time:
+//   - by default, as an array of structs, with x and y of each
+//     element together;
+//   - if USE_SOA is defined, as a struct of arrays, with all x
+//     values in one array and all y values in another.
+// Kernels see an array through double2ptr (or const_double2ptr for
+// read-only use), and index it with [] as they would a double2*.
+// An element reads as a double2, and a non-const element may be
+// assigned or updated as one, or through its .x and .y members.
+// Arrays are created with Memory::alloc2 and released with
+// Memory::free, or taken as scratch arrays with Memory::scratch2.
+
+#ifndef USE_SOA
+
+typedef double2* double2ptr;
+typedef const double2* const_double2ptr;
+typedef double2& double2ref;
+typedef const double2& const_double2ref;
+
+namespace Memory {
+
+inline double2ptr alloc2(const int count, const char* name = NULL) {
+    return alloc<double2>(count, name);
+}
+
+inline double2ptr scratch2(const int count) {
+    return scratch<double2>(count);
+}
+
+};  // namespace Memory
+
+#else  // USE_SOA
+
+// reference to one element of a double2ptr
+struct double2ref
+{
+    double& x;
+    double& y;
+    inline double2ref(double& x_, double& y_) : x(x_), y(y_) {}
+
+    inline operator double2() const { return double2(x, y); }
+
+    inline double2ref& operator=(const double2& v2)
+    {
+        x = v2.x;
+        y = v2.y;
+        return(*this);
+    }
+
+    inline double2ref& operator=(const double2ref& v2)
+    {
+        x = v2.x;
+        y = v2.y;
+        return(*this);
+    }
+
+    inline double2ref& operator+=(const double2& v2)
+    {
+        x += v2.x;
+        y += v2.y;
+        return(*this);
+    }
+
+    inline double2ref& operator-=(const double2& v2)
+    {
+        x -= v2.x;
+        y -= v2.y;
+        return(*this);
+    }
+
+    inline double2ref& operator*=(const double& r)
+    {
+        x *= r;
+        y *= r;
+        return(*this);
+    }
+
+    inline double2ref& operator/=(const double& r)
+    {
+        x /= r;
+        y /= r;
+        return(*this);
+    }
+};
+
+typedef double2 const_double2ref;
+
+struct double2ptr
+{
+    double* x;
+    double* y;
+    inline double2ptr() : x(NULL), y(NULL) {}
+    inline double2ptr(double* x_, double* y_) : x(x_), y(y_) {}
+
+    inline double2ref operator[](const int i) const
+    {
+        return double2ref(x[i], y[i]);
+    }
+
+    // allows testing for a null array with if (p)
+    typedef double* double2ptr::*bool_type;
+    inline operator bool_type() const { return x ? &double2ptr::x : 0; }
+};
+
+struct const_double2ptr
+{
+    const double* x;
+    const double* y;
+    inline const_double2ptr() : x(NULL), y(NULL) {}
+    inline const_double2ptr(const double* x_, const double* y_)
+        : x(x_), y(y_) {}
+    inline const_double2ptr(const double2ptr& p) : x(p.x), y(p.y) {}
+
+    inline double2 operator[](const int i) const
+    {
+        return double2(x[i], y[i]);
+    }
+
+    // allows testing for a null array with if (p)
+    typedef const double* const_double2ptr::*bool_type;
+    inline operator bool_type() const
+    {
+        return x ? &const_double2ptr::x : 0;
+    }
+};
+
+namespace Memory {
+
+// both components come from one allocation, x values first
+inline double2ptr alloc2(const int count, const char* name = NULL) {
+    double* xy = alloc<double>(2 * count, name);
+    return double2ptr(xy, xy + count);
+}
+
+inline double2ptr scratch2(const int count) {
+    double* xy = scratch<double>(2 * count);
+    return double2ptr(xy, xy + count);
+}
+
+inline void free(const double2ptr& ptr) {
+    free(ptr.x);
+}
+
+};  // namespace Memory
+
+#endif  // USE_SOA
+
+
+#endif /* VEC2ARRAY_HH_ */
@@ -0,0 +1,316 @@
+/*
+ * VecW.hh
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * Copyright (c) 2026, Triad National Security, LLC.
+ * All rights reserved.
+ * Use of this source code is governed by a BSD-style open-source
+ * license; see top-level LICENSE file for full license text.
+ */
+
+#ifndef VECW_HH_
+#define VECW_HH_
+
+#include <cmath>
+
+#include "Vec2.hh"
+
+
+// These structs hold W values of a field at one mesh element, one
+// for each problem ("lane") in a HydroLanes group.  Their
+// operators and functions work lane by lane, with the same
+// arithmetic in each lane as the double and double2 (Vec2.hh)
+// versions, so that a kernel written for one gives the same
+// results, lane by lane, for the other (see FieldTypes.hh).
+// A double converts to a value with the same number in every lane.
+// Comparisons give a maskW, which select() uses in place of ?:.
+// As in Vec2.hh, all functions are inline.
+
+template <int W>
+struct maskW
+{
+    bool v[W];
+
+    // number of lanes that are set
+    friend inline int countTrue(const maskW& m)
+    {
+        int n = 0;
+        for (int w = 0; w < W; ++w) n += m.v[w];
+        return(n);
+    }
+};
+
+
+template <int W>
+struct intW
+{
+    int v[W];
+    inline intW() { for (int w = 0; w < W; ++w) v[w] = 0; }
+    inline intW(const int& i) { for (int w = 0; w < W; ++w) v[w] = i; }
+
+    friend inline intW select(const maskW<W>& m, const intW& a,
+            const intW& b)
+    {
+        intW r;
+        for (int w = 0; w < W; ++w) r.v[w] = (m.v[w] ? a.v[w] : b.v[w]);
+        return(r);
+    }
+};
+
+
+template <int W>
+struct doubleW
+{
+    double v[W];
+    inline doubleW() { for (int w = 0; w < W; ++w) v[w] = 0.; }
+    inline doubleW(const double& r) { for (int w = 0; w < W; ++w) v[w] = r; }
+
+    inline doubleW& operator+=(const doubleW& r)
+    {
+        for (int w = 0; w < W; ++w) v[w] += r.v[w];
+        return(*this);
+    }
+
+    inline doubleW& operator-=(const doubleW& r)
+    {
+        for (int w = 0; w < W; ++w) v[w] -= r.v[w];
+        return(*this);
+    }
+
+    inline doubleW& operator*=(const doubleW& r)
+    {
+        for (int w = 0; w < W; ++w) v[w] *= r.v[w];
+        return(*this);
+    }
+
+    inline doubleW& operator/=(const doubleW& r)
+    {
+        for (int w = 0; w < W; ++w) v[w] /= r.v[w];
+        return(*this);
+    }
+
+    friend inline doubleW operator-(const doubleW& a)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = -a.v[w];
+        return(r);
+    }
+
+    friend inline doubleW operator+(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = a.v[w] + b.v[w];
+        return(r);
+    }
+
+    friend inline doubleW operator-(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = a.v[w] - b.v[w];
+        return(r);
+    }
+
+    friend inline doubleW operator*(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = a.v[w] * b.v[w];
+        return(r);
+    }
+
+    friend inline doubleW operator/(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = a.v[w] / b.v[w];
+        return(r);
+    }
+
+    friend inline maskW<W> operator<(const doubleW& a, const doubleW& b)
+    {
+        maskW<W> m;
+        for (int w = 0; w < W; ++w) m.v[w] = (a.v[w] < b.v[w]);
+        return(m);
+    }
+
+    friend inline maskW<W> operator>(const doubleW& a, const doubleW& b)
+    {
+        maskW<W> m;
+        for (int w = 0; w < W; ++w) m.v[w] = (a.v[w] > b.v[w]);
+        return(m);
+    }
+
+    friend inline maskW<W> operator<=(const doubleW& a, const doubleW& b)
+    {
+        maskW<W> m;
+        for (int w = 0; w < W; ++w) m.v[w] = (a.v[w] <= b.v[w]);
+        return(m);
+    }
+
+    friend inline doubleW select(const maskW<W>& m, const doubleW& a,
+            const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = (m.v[w] ? a.v[w] : b.v[w]);
+        return(r);
+    }
+
+    // min and max as std::min and std::max:  b only if it is
+    // less (greater) than a
+    friend inline doubleW min(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w)
+            r.v[w] = (b.v[w] < a.v[w] ? b.v[w] : a.v[w]);
+        return(r);
+    }
+
+    friend inline doubleW max(const doubleW& a, const doubleW& b)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w)
+            r.v[w] = (a.v[w] < b.v[w] ? b.v[w] : a.v[w]);
+        return(r);
+    }
+
+    friend inline doubleW sqrt(const doubleW& a)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = std::sqrt(a.v[w]);
+        return(r);
+    }
+
+    friend inline doubleW abs(const doubleW& a)
+    {
+        doubleW r;
+        for (int w = 0; w < W; ++w) r.v[w] = std::abs(a.v[w]);
+        return(r);
+    }
+};
+
+
+// components are stored separately, so that each is contiguous
+template <int W>
+struct double2W
+{
+    doubleW<W> x, y;
+    inline double2W() {}
+    inline double2W(const doubleW<W>& x_, const doubleW<W>& y_)
+        : x(x_), y(y_) {}
+    inline double2W(const double2& v2) : x(v2.x), y(v2.y) {}
+
+    inline double2W& operator+=(const double2W& v2)
+    {
+        x += v2.x;
+        y += v2.y;
+        return(*this);
+    }
+
+    inline double2W& operator-=(const double2W& v2)
+    {
+        x -= v2.x;
+        y -= v2.y;
+        return(*this);
+    }
+
+    inline double2W& operator*=(const doubleW<W>& r)
+    {
+        x *= r;
+        y *= r;
+        return(*this);
+    }
+
+    inline double2W& operator/=(const doubleW<W>& r)
+    {
+        x /= r;
+        y /= r;
+        return(*this);
+    }
+
+    friend inline double2W operator-(const double2W& v)
+    {
+        return(double2W(-v.x, -v.y));
+    }
+
+    friend inline double2W operator+(const double2W& v1, const double2W& v2)
+    {
+        return(double2W(v1.x + v2.x, v1.y + v2.y));
+    }
+
+    friend inline double2W operator-(const double2W& v1, const double2W& v2)
+    {
+        return(double2W(v1.x - v2.x, v1.y - v2.y));
+    }
+
+    friend inline double2W operator*(const double2W& v, const doubleW<W>& r)
+    {
+        return(double2W(v.x * r, v.y * r));
+    }
+
+    friend inline double2W operator*(const doubleW<W>& r, const double2W& v)
+    {
+        return(double2W(v.x * r, v.y * r));
+    }
+
+    friend inline double2W operator/(const double2W& v, const doubleW<W>& r)
+    {
+        doubleW<W> rinv = 1. / r;
+        return(double2W(v.x * rinv, v.y * rinv));
+    }
+
+    friend inline doubleW<W> dot(const double2W& v1, const double2W& v2)
+    {
+        return(v1.x * v2.x + v1.y * v2.y);
+    }
+
+    friend inline doubleW<W> cross(const double2W& v1, const double2W& v2)
+    {
+        return(v1.x * v2.y - v1.y * v2.x);
+    }
+
+    friend inline doubleW<W> length(const double2W& v)
+    {
+        return(sqrt(v.x * v.x + v.y * v.y));
+    }
+
+    friend inline doubleW<W> length2(const double2W& v)
+    {
+        return(v.x * v.x + v.y * v.y);
+    }
+
+    friend inline double2W rotateCCW(const double2W& v)
+    {
+        return(double2W(-v.y, v.x));
+    }
+
+    friend inline double2W rotateCW(const double2W& v)
+    {
+        return(double2W(v.y, -v.x));
+    }
+
+    friend inline double2W project(const double2W& v, const double2W& u)
+    {
+        return v - dot(v, u) * u;
+    }
+};
+
+
+// forms of the lane functions for one problem, so that the same
+// kernel code can be used for both
+
+inline double select(const bool c, const double a, const double b)
+{
+    return(c ? a : b);
+}
+
+inline int select(const bool c, const int a, const int b)
+{
+    return(c ? a : b);
+}
+
+inline int countTrue(const bool c)
+{
+    return(c ? 1 : 0);
+}
+
+
+#endif /* VECW_HH_ */
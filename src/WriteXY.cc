@@ -42,6 +42,25 @@ void WriteXY::write(
     vector<int> penumz((mype == 0 ? numpe : 1), 0);
     Parallel::gather(numz, &penumz[0]);
 
+    // if the mesh was reordered, put zones back in the order
+    // they were generated
+    const vector<int>& zoneorig = mesh->zoneorig;
+    vector<double> lzr, lze, lzp;
+    if (!zoneorig.empty()) {
+        lzr.resize(numz);
+        lze.resize(numz);
+        lzp.resize(numz);
+        for (int z = 0; z < numz; ++z) {
+            int zo = zoneorig[z];
+            lzr[zo] = zr[z];
+            lze[zo] = ze[z];
+            lzp[zo] = zp[z];
+        }
+        zr = &lzr[0];
+        ze = &lze[0];
+        zp = &lzp[0];
+    }
+
     vector<double> gzr(gnumz, 0), gze(gnumz, 0), gzp(gnumz, 0);
     Parallel::gatherv(&zr[0], numz, &gzr[0], &penumz[0]);
     Parallel::gatherv(&ze[0], numz, &gze[0], &penumz[0]);
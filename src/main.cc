@@ -17,6 +17,7 @@
 #include "Parallel.hh"
 #include "InputFile.hh"
 #include "Driver.hh"
+#include "Ensemble.hh"
 
 using namespace std;
 
@@ -25,15 +26,24 @@ int main(const int argc, const char** argv)
 {
     Parallel::init();
 
-    if (argc != 2) {
+    if (argc < 2) {
         if (Parallel::mype == 0)
-            cerr << "Usage: pennant <filename>" << endl;
+            cerr << "Usage: pennant <filename> [<filename> ...]" << endl;
         exit(1);
     }
 
     const char* filename = argv[1];
     InputFile inp(filename);
 
+    // several input files, or a parameter sweep, are run
+    // as an ensemble of independent problems
+    if (argc > 2 || Ensemble::hasSweep(inp)) {
+        Ensemble ens(argc - 1, &argv[1]);
+        ens.run();
+        Parallel::final();
+        return 0;
+    }
+
     string probname(filename);
     // strip .pnt suffix from filename
     int len = probname.length();
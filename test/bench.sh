@@ -0,0 +1,222 @@
+#!/bin/bash
+#
+# bench.sh
+#
+# Run a matrix of benchmark cases (problem x MPI ranks x OpenMP
+# threads x chunksize x huge page policy) using PENNANT's benchmark
+# mode, and write a CSV file of throughput, parallel efficiency,
+# peak memory and data TLB misses.
+#
+# Usage:  test/bench.sh <path to pennant binary>
+#
+# Settings are taken from the environment:
+#   BENCH_PROBS    problems (subdirectories of test/)
+#   BENCH_RANKS    MPI rank counts (1 runs without mpirun)
+#   BENCH_THREADS  OpenMP thread counts
+#   BENCH_CHUNKS   chunk sizes; "deck" uses the input file's value
+#   BENCH_PAGES    huge page policies (hugepages keyword:  none,
+#                  thp, hugetlb)
+#   BENCH_COUNTERS if 1, turn on perfcounters, to report dTLB misses
+#   BENCH_CYCLES   timed cycles per run
+#   BENCH_WARMUP   untimed warm-up cycles per run
+#   BENCH_DIR      working directory for runs
+#   BENCH_CSV      output file
+#   MPIRUN         MPI launcher, followed by rank count
+#
+# Each run is checked for correctness.  Problems with a .xy.std
+# file get an extra full-length run whose output is compared to
+# it; problems with a log in test/sample_outputs have the initial
+# energy and the time and dt at each reported cycle compared to
+# that log.  Parallel efficiency is relative to the run of the
+# same problem, chunksize and page policy using the fewest cores.
+#
+
+BINARY=${1:?usage: bench.sh <pennant binary>}
+BINARY=$(cd "$(dirname "$BINARY")" && pwd)/$(basename "$BINARY")
+TESTDIR=$(cd "$(dirname "$0")" && pwd)
+
+BENCH_PROBS=${BENCH_PROBS:-"sedov noh leblanc sedovflat nohpoly leblancbig"}
+BENCH_RANKS=${BENCH_RANKS:-"1"}
+BENCH_THREADS=${BENCH_THREADS:-"1 $(nproc 2>/dev/null || echo 1)"}
+BENCH_CHUNKS=${BENCH_CHUNKS:-"deck"}
+BENCH_PAGES=${BENCH_PAGES:-"none"}
+BENCH_COUNTERS=${BENCH_COUNTERS:-0}
+BENCH_CYCLES=${BENCH_CYCLES:-200}
+BENCH_WARMUP=${BENCH_WARMUP:-10}
+BENCH_DIR=${BENCH_DIR:-bench}
+BENCH_CSV=${BENCH_CSV:-bench.csv}
+MPIRUN=${MPIRUN:-"mpirun -np"}
+
+mkdir -p "$BENCH_DIR" || exit 1
+CSVTMP=$BENCH_DIR/rows.csv
+: > "$CSVTMP"
+
+
+# run pennant on a deck with given ranks and threads
+run_pennant() {
+    local deck=$1 ranks=$2 threads=$3
+    if [ "$ranks" -gt 1 ]; then
+        OMP_NUM_THREADS=$threads $MPIRUN "$ranks" "$BINARY" "$deck"
+    else
+        OMP_NUM_THREADS=$threads "$BINARY" "$deck"
+    fi
+}
+
+
+# compare .xy output to gold standard, ignoring zone order
+check_xy() {
+    local out=$1 std=$2
+    local a b
+    a=$(awk '/^#/ { f = $2; next } { print f, $2 }' "$out" |
+        sort -k1,1 -k2,2g)
+    b=$(awk '/^#/ { f = $2; next } { print f, $2 }' "$std" |
+        sort -k1,1 -k2,2g)
+    paste <(echo "$a") <(echo "$b") | awk '
+        function abs(x) { return x < 0 ? -x : x }
+        { n++
+          if ($1 != $3) bad = 1
+          if (abs($2 - $4) > 1.e-6 * (abs($4) + 1.e-10)) bad = 1 }
+        END { exit (bad || n == 0) }'
+}
+
+
+# compare energy and cycle reports to a sample output log
+check_log() {
+    local out=$1 ref=$2
+    awk '
+        function abs(x) { return x < 0 ? -x : x }
+        function near(x, y) { return abs(x - y) <= 1.e-4 * abs(y) }
+        FNR == 1 { file++ }
+        /^Energy check/ && !(file in e) { e[file] = $NF + 0 }
+        /^End cycle/ {
+            c = $3 + 0
+            t[file, c] = $6 + 0; dt[file, c] = $9 + 0
+            if (file == 1) cyc[c] = 1
+        }
+        END {
+            if (!near(e[1], e[2])) exit 1
+            for (c in cyc) {
+                if (!((2, c) in t)) continue
+                n++
+                if (!near(t[1, c], t[2, c]) ||
+                    !near(dt[1, c], dt[2, c])) exit 1
+            }
+            exit (n == 0)
+        }' "$out" "$ref"
+}
+
+
+for prob in $BENCH_PROBS; do
+    deck=$TESTDIR/$prob/$prob.pnt
+    if [ ! -f "$deck" ]; then
+        echo "bench.sh: no input file $deck" >&2
+        continue
+    fi
+    ref=$(ls "$TESTDIR"/sample_outputs/*/$prob.*out 2>/dev/null | head -1)
+    for chunk in $BENCH_CHUNKS; do
+        for pages in $BENCH_PAGES; do
+            for ranks in $BENCH_RANKS; do
+                for threads in $BENCH_THREADS; do
+                    name=$prob.r$ranks.t$threads.c$chunk.h$pages
+                    echo "running $name"
+
+                    # input file for benchmark run
+                    bdeck=$BENCH_DIR/$name.pnt
+                    grep -v "^ *\(benchcycles\|benchwarmup\|writexy\)" \
+                        "$deck" |
+                        grep -v "^ *\(hugepages\|perfcounters\)" > "$bdeck"
+                    if [ "$chunk" != deck ]; then
+                        sed -i "/^ *chunksize/d" "$bdeck"
+                        echo "chunksize $chunk" >> "$bdeck"
+                    fi
+                    echo "hugepages $pages" >> "$bdeck"
+                    cp "$bdeck" "$BENCH_DIR/$name.full.pnt"
+                    echo "benchcycles $BENCH_CYCLES" >> "$bdeck"
+                    echo "benchwarmup $BENCH_WARMUP" >> "$bdeck"
+                    [ "$BENCH_COUNTERS" = 1 ] && echo "perfcounters 1" >> "$bdeck"
+                    out=$BENCH_DIR/$name.out
+                    if ! run_pennant "$bdeck" "$ranks" "$threads" \
+                            > "$out" 2>&1; then
+                        echo "  run failed; see $out" >&2
+                        echo "$prob,$ranks,$threads,$chunk,$pages,,,,,,,,,,run failed" \
+                            >> "$CSVTMP"
+                        continue
+                    fi
+
+                    # correctness check
+                    check=none
+                    std=$TESTDIR/$prob/$prob.xy.std
+                    if [ -f "$std" ]; then
+                        fdeck=$BENCH_DIR/$name.full.pnt
+                        echo "writexy 1" >> "$fdeck"
+                        if run_pennant "$fdeck" "$ranks" "$threads" \
+                                > "$BENCH_DIR/$name.full.out" 2>&1 &&
+                                check_xy "$BENCH_DIR/$name.full.xy" "$std"; then
+                            check=pass
+                        else
+                            check=fail
+                        fi
+                    elif [ -n "$ref" ]; then
+                        if check_log "$out" "$ref"; then
+                            check=pass
+                        else
+                            check=fail
+                        fi
+                    fi
+                    [ $check = fail ] && echo "  correctness check FAILED" >&2
+
+                    # extract benchmark statistics
+                    awk -v prob=$prob -v ranks=$ranks -v threads=$threads \
+                        -v chunk=$chunk -v pages=$pages -v check=$check '
+                        /^Zones:/ { zones = $2 }
+                        /^--- Benchmark/ { n = $3; sub("\\(", "", n) }
+                        /^cycle time median:/ { med = $4 }
+                        /^cycle time mean:/ { mean = $4 }
+                        /^cycle time stddev:/ { sd = $4 }
+                        /^zone-cycles\/s \(median\):/ { zcs = $3 }
+                        /^peak RSS \(MB\):/ { rssmax = $4; rsstot = $6 }
+                        /^dTLB misses per zone-cycle:/ {
+                            tlb = ($5 == "n/a" ? "" : $5) }
+                        END {
+                            printf "%s,%d,%d,%s,%s,%d,%d,%.6e,%.6e,%.6e,%.6e,%.1f,%.1f,%s,%s\n",
+                                prob, ranks, threads, chunk, pages, zones, n,
+                                med, mean, sd, zcs, rssmax, rsstot, tlb, check
+                        }' "$out" >> "$CSVTMP"
+                done
+            done
+        done
+    done
+done
+
+
+# add parallel efficiency column and write CSV
+awk -F, '
+    { row[NR] = $0; key = $1 "," $4 "," $5; cores = $2 * $3
+      if ($11 != "" && (!(key in bcores) || cores < bcores[key])) {
+          bcores[key] = cores; brate[key] = $11
+      } }
+    END {
+        print "problem,ranks,threads,chunksize,hugepages,zones,cycles," \
+              "median_s,mean_s,stddev_s,zone_cycles_per_s," \
+              "efficiency,rss_max_mb,rss_total_mb," \
+              "dtlb_miss_per_zone_cycle,check"
+        for (i = 1; i <= NR; i++) {
+            split(row[i], f, ",")
+            key = f[1] "," f[4] "," f[5]; cores = f[2] * f[3]
+            eff = ""
+            if (f[11] != "" && brate[key] > 0) {
+                base = brate[key] / bcores[key]
+                eff = sprintf("%.3f", f[11] / cores / base)
+            }
+            printf "%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s\n",
+                f[1], f[2], f[3], f[4], f[5], f[6], f[7], f[8],
+                f[9], f[10], f[11], eff, f[12], f[13], f[14], f[15]
+        }
+    }' "$CSVTMP" > "$BENCH_CSV"
+
+echo "wrote $BENCH_CSV"
+if grep -q ",fail$\|,run failed" "$BENCH_CSV"; then
+    echo "some runs failed or gave incorrect results" >&2
+    exit 1
+fi
+exit 0